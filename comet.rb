@@ -35,6 +35,62 @@ software 'mmio-test', depends: ['hal'] do
   end
 end
 
+software 'scan-test', depends: ['hal'] do
+  source language: :cpp, headers: ['src', 'spec/support', *headers] do
+    import 'spec/lpc1100/scan/board.cpp'
+
+    inject &cppflags
+  end
+end
+
+software 'arithmetic-test', depends: ['hal'] do
+  source language: :cpp, headers: ['src', 'spec/support', *headers] do
+    import 'spec/lpc1100/arithmetic/board.cpp'
+
+    inject &cppflags
+  end
+end
+
+software 'stdlib-test', depends: ['hal'] do
+  source language: :cpp, headers: ['src', 'spec/support', *headers] do
+    import 'spec/lpc1100/stdlib/board.cpp'
+
+    inject &cppflags
+  end
+end
+
+software 'runtime-test', depends: ['hal'] do
+  source language: :cpp, headers: ['src', 'spec/support', *headers] do
+    import 'spec/lpc1100/runtime/board.cpp'
+
+    inject &cppflags
+  end
+end
+
+software 'runtime-libgcc-test', depends: ['hal-libgcc'] do
+  source language: :cpp, headers: ['src', 'spec/support', *headers] do
+    import 'spec/lpc1100/runtime/board.cpp'
+
+    inject &cppflags
+  end
+end
+
+software 'frequency-scaling-test', depends: ['hal'] do
+  source language: :cpp, headers: ['src', 'spec/support', *headers] do
+    import 'spec/lpc1100/frequency_scaling/board.cpp'
+
+    inject &cppflags
+  end
+end
+
+software 'iocon-test', depends: ['hal'] do
+  source language: :cpp, headers: ['src', 'spec/support', *headers] do
+    import 'spec/lpc1100/iocon/board.cpp'
+
+    inject &cppflags
+  end
+end
+
 hardware 'control', targets: :lpc1100 do
   source language: :cpp, headers: ['src', *headers] do
     import 'src/app/control/lpc1100.cpp'
@@ -76,6 +132,34 @@ hardware 'hal', targets: :lpc1100 do
   import 'gcc'
 end
 
+# The same HAL without the RTL arithmetic runtime, so that the run-time ABI
+# routines are all linked from libgcc; only used to benchmark the runtime.
+hardware 'hal-libgcc', targets: :lpc1100 do
+  source language: :cpp, headers: ['src', *headers] do
+    import 'src/hal/lpc1100/**/*.cpp'
+    import 'src/rtl/cortex-m0/**/*.cpp'
+    import 'src/rtl/*.cpp'
+
+    inject &cppflags
+    define :RTL_CORTEX_M0
+    define :RTL_LIBGCC_ARITHMETIC
+  end
+
+  source language: :native do
+    import 'src/rtl/cortex-m0/init.S'
+  end
+
+  linker 'arm-none-eabi', isa: 'armv6-m', cpu: 'cortex-m0', opt: 2 do
+    script 'src/hal/lpc1100/layout.ld'
+    option :static
+    option :nostdlib
+    option :'fuse-ld' => 'bfd'
+    option 'L/usr/lib/gcc/arm-none-eabi/7.2.0/armv6-m'
+  end
+
+  import 'gcc'
+end
+
 firmware 'bowshock', imports: ['main'] do
   target :lpc1100 do
     elf 'bin/bowshock.elf'
@@ -99,3 +183,59 @@ firmware 'mmio-test', imports: ['mmio-test'] do
     map 'bin/lpc1100-mmio-firmware.map'
   end
 end
+
+firmware 'scan-test', imports: ['scan-test'] do
+  target :lpc1100 do
+    elf 'bin/lpc1100-scan-firmware.elf'
+    bin 'bin/lpc1100-scan-firmware.bin'
+    map 'bin/lpc1100-scan-firmware.map'
+  end
+end
+
+firmware 'arithmetic-test', imports: ['arithmetic-test'] do
+  target :lpc1100 do
+    elf 'bin/lpc1100-arithmetic-firmware.elf'
+    bin 'bin/lpc1100-arithmetic-firmware.bin'
+    map 'bin/lpc1100-arithmetic-firmware.map'
+  end
+end
+
+firmware 'stdlib-test', imports: ['stdlib-test'] do
+  target :lpc1100 do
+    elf 'bin/lpc1100-stdlib-firmware.elf'
+    bin 'bin/lpc1100-stdlib-firmware.bin'
+    map 'bin/lpc1100-stdlib-firmware.map'
+  end
+end
+
+firmware 'runtime-test', imports: ['runtime-test'] do
+  target :lpc1100 do
+    elf 'bin/lpc1100-runtime-firmware.elf'
+    bin 'bin/lpc1100-runtime-firmware.bin'
+    map 'bin/lpc1100-runtime-firmware.map'
+  end
+end
+
+firmware 'runtime-libgcc-test', imports: ['runtime-libgcc-test'] do
+  target :lpc1100 do
+    elf 'bin/lpc1100-runtime-libgcc-firmware.elf'
+    bin 'bin/lpc1100-runtime-libgcc-firmware.bin'
+    map 'bin/lpc1100-runtime-libgcc-firmware.map'
+  end
+end
+
+firmware 'frequency-scaling-test', imports: ['frequency-scaling-test'] do
+  target :lpc1100 do
+    elf 'bin/lpc1100-frequency-scaling-firmware.elf'
+    bin 'bin/lpc1100-frequency-scaling-firmware.bin'
+    map 'bin/lpc1100-frequency-scaling-firmware.map'
+  end
+end
+
+firmware 'iocon-test', imports: ['iocon-test'] do
+  target :lpc1100 do
+    elf 'bin/lpc1100-iocon-firmware.elf'
+    bin 'bin/lpc1100-iocon-firmware.bin'
+    map 'bin/lpc1100-iocon-firmware.map'
+  end
+end
@@ -2,7 +2,10 @@
 
 #include <hal/lpc1100/system.hpp>
 #include <hal/lpc1100/digital_io.hpp>
+#include <hal/lpc1100/pin_capture.hpp>
+#include <hal/lpc1100/debounce.hpp>
 #include <hal/lpc1100/uart.hpp>
+#include <hal/lpc1100/ticks.hpp>
 #include <rtl/assert.hpp>
 
 #include "simple_json.hpp"
@@ -11,6 +14,10 @@
 namespace dev = hal::lpc1100;
 namespace json = spec::json;
 
+namespace hal::lpc1100 {
+template <> struct clock_rate<clock_source::core> : clock_rate<clock_source::irc> {}; // reset configuration
+}
+
 constexpr auto input_pin = dev::pin::PIO0_7;
 constexpr auto output_pin = dev::pin::PIO0_8;
 
@@ -43,10 +50,72 @@ auto dont_drive_and_check(dev::digital_input<input_pin>& input) {
   // and checking the state of the input pin, as the microcontroller pulldowns and
   // pullups are quite weak and will take a while to raise or lower the voltage
   // (especially if this is done on a breadboard with high wire capacitance)
-  for (volatile auto dummy = 0; dummy < 100; ++dummy);
+  dev::delay(100_us);
   return input.state();
 }
 
+auto edge_when_driven_high(dev::digital_input<input_pin>& input) {
+  auto output = dev::digital_output<output_pin>{hal::logic_level::low};
+  auto rising = input.wait_edge(dev::edge::rising);
+
+  output.drive_high();
+  dev::delay(10_us);
+  return rising.is_complete();
+}
+
+auto capture_toggles(dev::digital_input<input_pin>& input) {
+  auto output = dev::digital_output<output_pin>{hal::logic_level::low};
+  auto capture = dev::pin_capture<dev::peripheral::ct32b0, 64, input_pin>{input};
+
+  for (auto i = 0; i < 16; ++i) {
+    output.drive((i % 2 == 0) ? hal::logic_level::high : hal::logic_level::low);
+    dev::delay(20_us);
+  }
+
+  dev::pin_change changes[64];
+  return static_cast<rtl::u32>(capture.drain(changes, 64));
+}
+
+// @brief Measures the cycles from driving an edge to a fixed amount of work after it, during which the interrupt (if
+//        any) preempts it.
+auto edge_cycles(dev::digital_output<output_pin>& output) {
+  output.drive_low();
+  dev::delay(20_us);
+
+  auto start = dev::cycle_counter::now();
+  output.drive_high();
+
+  for (auto i = 0; i < 32; ++i) {
+    asm volatile ("nop");
+  }
+
+  return dev::cycle_counter::since(start);
+}
+
+// @brief Returns the cycles taken by the capture of one edge, from interrupt entry to exit, as the difference between
+//        an edge with and without a capture listening to it.
+auto capture_handler_cycles(dev::digital_input<input_pin>& input) {
+  auto output = dev::digital_output<output_pin>{hal::logic_level::low};
+  auto baseline = edge_cycles(output);
+
+  auto capture = dev::pin_capture<dev::peripheral::ct32b0, 64, input_pin>{input};
+  auto captured = edge_cycles(output);
+
+  // an edge which the capture handler did not preempt would wrap the difference around, or divide the rate by zero
+  rtl::assert(captured > baseline, TRACE("capture handler did not run within the measured edge"));
+  return captured - baseline;
+}
+
+auto debounce_when_driven_high(dev::digital_input<input_pin>& input) {
+  auto output = dev::digital_output<output_pin>{hal::logic_level::low};
+  auto inputs = dev::debouncer<dev::peripheral::ct32b1, input_pin>{input, 1_ms};
+  auto change = inputs.wait_change<input_pin>();
+
+  output.drive_high();
+  change.wait();
+  return inputs.state<input_pin>();
+}
+
 auto run_spec(const test_params& params) {
   auto input = dev::digital_input<input_pin>{params.input_termination};
 
@@ -54,12 +123,21 @@ auto run_spec(const test_params& params) {
   auto state_when_not_driven = dont_drive_and_check(input);
   auto state_when_driven_high = drive_high_and_check(input);
   auto state_when_not_driven_again = dont_drive_and_check(input);
+  auto rising_edge_seen = edge_when_driven_high(input);
+  auto edges_captured = capture_toggles(input);
+  auto handler_cycles = capture_handler_cycles(input);
+  auto debounced_state_when_driven_high = debounce_when_driven_high(input);
 
   return json::object{
     std::pair{"state_when_driven_low", state_when_driven_low},
     std::pair{"state_when_not_driven", state_when_not_driven},
     std::pair{"state_when_driven_high", state_when_driven_high},
     std::pair{"state_when_not_driven_again", state_when_not_driven_again},
+    std::pair{"rising_edge_seen", rising_edge_seen},
+    std::pair{"edges_captured", edges_captured},
+    std::pair{"capture_handler_cycles", handler_cycles},
+    std::pair{"max_capture_rate", dev::clock_rate<dev::clock_source::core>::value / handler_cycles},
+    std::pair{"debounced_state_when_driven_high", debounced_state_when_driven_high},
   };
 }
 
@@ -9,6 +9,15 @@ describe Breadboard, hardware: true do
     context 'with the input pin pulled down' do
       let(:params) { { termination: :pulldown } }
 
+      # Edges closer together than the capture handler takes to run are
+      # merged, so its cycle count bounds the edge rate a capture can follow.
+      it 'reports the cycles taken to capture an edge' do
+        cycles = board.response.capture_handler_cycles
+        puts "pin_capture: #{cycles} cycles per edge, at most #{board.response.max_capture_rate} edges per second"
+        expect(cycles).to be > 0
+        expect(board.response.max_capture_rate).to be > 0
+      end
+
       it 'is low when driven low' do
         expect(board.response.state_when_driven_low).to eq 'low'
       end
@@ -24,6 +33,18 @@ describe Breadboard, hardware: true do
       it 'is low when not driven again' do
         expect(board.response.state_when_not_driven_again).to eq 'low'
       end
+
+      it 'sees the rising edge when driven high' do
+        expect(board.response.rising_edge_seen).to be true
+      end
+
+      it 'captures every edge when toggled' do
+        expect(board.response.edges_captured).to eq 16
+      end
+
+      it 'debounces to high when driven high' do
+        expect(board.response.debounced_state_when_driven_high).to eq 'high'
+      end
     end
 
     context 'with the input pin pulled up' do
@@ -44,6 +65,18 @@ describe Breadboard, hardware: true do
       it 'is high when not driven again' do
         expect(board.response.state_when_not_driven_again).to eq 'high'
       end
+
+      it 'sees the rising edge when driven high' do
+        expect(board.response.rising_edge_seen).to be true
+      end
+
+      it 'captures every edge when toggled' do
+        expect(board.response.edges_captured).to eq 16
+      end
+
+      it 'debounces to high when driven high' do
+        expect(board.response.debounced_state_when_driven_high).to eq 'high'
+      end
     end
 
     context 'with the input pin in repeater mode' do
@@ -64,6 +97,18 @@ describe Breadboard, hardware: true do
       it 'is high when not driven again' do
         expect(board.response.state_when_not_driven_again).to eq 'high'
       end
+
+      it 'sees the rising edge when driven high' do
+        expect(board.response.rising_edge_seen).to be true
+      end
+
+      it 'captures every edge when toggled' do
+        expect(board.response.edges_captured).to eq 16
+      end
+
+      it 'debounces to high when driven high' do
+        expect(board.response.debounced_state_when_driven_high).to eq 'high'
+      end
     end
   end
 end
@@ -0,0 +1,51 @@
+#include <cstdlib>
+
+#include <hal/lpc1100/board.hpp>
+#include <hal/lpc1100/uart.hpp>
+
+// board pin maps are only compiled on the host, as they program the device and the UART driver contains its interrupt
+// handler; each macro selects a board which must fail compilation
+
+namespace dev = hal::lpc1100;
+
+using board = dev::board<dev::pin_function<dev::pin::TXD, dev::peripheral_function::uart_tx>,
+                         dev::pin_function<dev::pin::RXD, dev::peripheral_function::uart_rx>,
+                         dev::gpio_output<dev::pin::PIO0_8, hal::logic_level::high>,
+                         dev::gpio_input<dev::pin::PIO0_7, dev::iocon_pullup>>;
+
+static_assert(board::assigns<dev::pin::PIO1_7>);
+static_assert(board::assigns<dev::pin::MISO0>);
+static_assert(!board::assigns<dev::pin::PIO0_9>);
+
+static_assert(board::assigns_function<dev::pin::TXD, dev::peripheral_function::uart_tx>);
+static_assert(board::assigns_function<dev::pin::PIO1_6, dev::peripheral_function::uart_rx>);
+static_assert(!board::assigns_function<dev::pin::PIO0_7, dev::peripheral_function::uart_cts>);
+static_assert(!board::assigns_function<dev::pin::PIO0_8, dev::peripheral_function::uart_tx>);
+
+static_assert(dev::detail::distinct_pins<0, 1, 41>());
+static_assert(!dev::detail::distinct_pins<8, 1, static_cast<std::size_t>(dev::pin::MISO0)>());
+
+// a UART constructed from the board
+[[maybe_unused]] auto open_uart(const board& pins) {
+  return dev::uart0(pins, rtl::quantity<rtl::u32, rtl::hertz>{9600});
+}
+
+#if defined(ALIASED_PINS)
+using aliased = dev::board<dev::gpio_output<dev::pin::PIO0_8, hal::logic_level::low>,
+                           dev::gpio_input<dev::pin::MISO0>>;
+static_assert(sizeof(aliased) != 0);
+#endif
+
+#if defined(MISSING_FUNCTION)
+using missing = dev::board<dev::pin_function<dev::pin::PIO0_4, dev::peripheral_function::uart_tx>>;
+static_assert(sizeof(missing) != 0);
+#endif
+
+#if defined(UART_PINS_NOT_ASSIGNED)
+using gpio_only = dev::board<dev::gpio_output<dev::pin::TXD, hal::logic_level::high>,
+                             dev::gpio_input<dev::pin::RXD>>;
+
+auto open_unassigned_uart(const gpio_only& pins) {
+  return dev::uart0(pins, rtl::quantity<rtl::u32, rtl::hertz>{9600});
+}
+#endif
@@ -0,0 +1,22 @@
+describe 'dev::board', host: true do
+  subject(:program) { HostProgram.new 'spec/host/board/checks.cpp' }
+
+  it 'accepts a board and a driver taking its pins from it' do
+    expect(program.compile).to have_attributes(output: '', success?: true)
+  end
+
+  it 'rejects a pin assigned twice under two of its aliases' do
+    expect(program.compile('ALIASED_PINS'))
+      .to have_attributes(output: /pin assigned twice on the board/, success?: false)
+  end
+
+  it 'rejects a function the pin does not provide' do
+    expect(program.compile('MISSING_FUNCTION'))
+      .to have_attributes(output: /pin does not provide this peripheral function/, success?: false)
+  end
+
+  it 'rejects a driver whose pins the board does not assign to it' do
+    expect(program.compile('UART_PINS_NOT_ASSIGNED'))
+      .to have_attributes(output: /board does not assign the UART transmit pin/, success?: false)
+  end
+end
@@ -0,0 +1,73 @@
+#include <cstdlib>
+
+#include <rtl/bounded.hpp>
+
+#include "host_checks.hpp"
+
+using rtl::i64;
+
+template <i64 lo, i64 hi> using bounded = rtl::bounded_quantity<rtl::dimensionless, lo, hi>;
+
+static_assert(std::is_same<bounded<-2000000000, 0>::value_type, rtl::i32>::value);
+static_assert(std::is_same<bounded<0, 4000000000>::value_type, rtl::u32>::value);
+
+// @brief Bounded quantity holding a value only known at runtime, so that the operations are not constant folded.
+template <i64 lo, i64 hi> auto runtime(i64 value) {
+  volatile auto opaque = value;
+  return bounded<lo, hi>::clamp(rtl::quantity<i64, rtl::dimensionless>{opaque});
+}
+
+// @brief Checks every operation on the corners of two ranges against 128-bit arithmetic; the program is built with
+//        the undefined behaviour sanitizer, so an overflow in an intermediate type also fails.
+template <i64 lo1, i64 hi1, i64 lo2, i64 hi2> auto check_ranges() {
+  using range = rtl::detail::interval<lo1, hi1, lo2, hi2>;
+
+  for (auto a : {lo1, hi1}) {
+    for (auto b : {lo2, hi2}) {
+      auto x = runtime<lo1, hi1>(a);
+      auto y = runtime<lo2, hi2>(b);
+
+      if constexpr (range::sum_valid) {
+        CHECK(static_cast<__int128>((x + y).get()) == static_cast<__int128>(a) + b);
+      }
+
+      if constexpr (range::difference_valid) {
+        CHECK(static_cast<__int128>((x - y).get()) == static_cast<__int128>(a) - b);
+      }
+
+      if constexpr (range::product_valid) {
+        CHECK(static_cast<__int128>((x * y).get()) == static_cast<__int128>(a) * b);
+      }
+
+      if constexpr (range::quotient_valid) {
+        CHECK(static_cast<__int128>((x / y).get()) == static_cast<__int128>(a) / b);
+      }
+    }
+  }
+}
+
+int main() {
+  // sums and differences leaving the range of both operands
+  check_ranges<-2000000000, 0, -2000000000, 0>();
+  check_ranges<0, 2000000000, 0, 2000000000>();
+  check_ranges<0, 4000000000, 0, 4000000000>();
+  check_ranges<-2000000000, 0, 0, 2000000000>();
+  check_ranges<0, 2000000000, -2000000000, 0>();
+  check_ranges<-100, 100, -100, 100>();
+  check_ranges<0, 255, 0, 255>();
+  check_ranges<-128, 127, -128, 127>();
+  check_ranges<0, 65535, -32768, 32767>();
+
+  // the edges of the 32-bit types
+  check_ranges<std::numeric_limits<rtl::i32>::min(), std::numeric_limits<rtl::i32>::max(),
+               std::numeric_limits<rtl::i32>::min(), std::numeric_limits<rtl::i32>::max()>();
+  check_ranges<0, std::numeric_limits<rtl::u32>::max(), 0, std::numeric_limits<rtl::u32>::max()>();
+  check_ranges<std::numeric_limits<rtl::i32>::min(), -1, -1, -1>();
+  check_ranges<std::numeric_limits<rtl::i64>::min() / 2, std::numeric_limits<rtl::i64>::max() / 2, -1, 1>();
+
+  // unary minus of the most negative 32-bit value
+  CHECK((-runtime<std::numeric_limits<rtl::i32>::min(), 0>(std::numeric_limits<rtl::i32>::min())).get()
+        == -static_cast<i64>(std::numeric_limits<rtl::i32>::min()));
+
+  return spec::host::report();
+}
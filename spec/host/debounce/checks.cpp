@@ -0,0 +1,74 @@
+#include <cstdlib>
+
+#include <hal/lpc1100/debounce.hpp>
+
+// the vertical counters are only compiled on the host, as the debouncer pulls in the interrupt vectors of the device;
+// each check is a constant expression fed with a sequence of port samples
+
+using hal::lpc1100::detail::vertical_counter;
+using rtl::u32;
+
+// @brief Feeds the same sample a number of times, returning the pins accepted by the last one.
+constexpr auto feed(vertical_counter& counter, u32 sample, int times) {
+  auto changed = u32{0};
+
+  for (auto i = 0; i < times; ++i) {
+    changed = counter.update(sample);
+  }
+
+  return changed;
+}
+
+constexpr auto accepts_after_four_samples() {
+  auto counter = vertical_counter{};
+
+  // the first three samples of a new level only advance the counter, the fourth is accepted
+  for (auto i = 0; i < 3; ++i) {
+    if (counter.update(0b1) != 0 || counter.stable != 0) {
+      return false;
+    }
+  }
+
+  if (counter.update(0b1) != 0b1 || counter.stable != 0b1) {
+    return false;
+  }
+
+  // after which the level is no longer a change, and going back takes four samples again
+  return counter.update(0b1) == 0 && feed(counter, 0b0, 3) == 0 && counter.update(0b0) == 0b1 && counter.stable == 0;
+}
+
+constexpr auto restarts_after_glitch() {
+  auto counter = vertical_counter{};
+
+  // a sample of the stable level after one, two or three samples of a new level starts the count over
+  for (auto glitch = 1; glitch <= 3; ++glitch) {
+    if (feed(counter, 0b1, glitch) != 0 || counter.update(0b0) != 0) {
+      return false;
+    }
+  }
+
+  return feed(counter, 0b1, 3) == 0 && counter.update(0b1) == 0b1 && counter.stable == 0b1;
+}
+
+constexpr auto counts_bits_independently() {
+  auto counter = vertical_counter{};
+
+  // bit 0 changes first, bit 5 two samples later, and bit 11 glitches all along
+  constexpr u32 samples[] = {0b000000000001, 0b100000000001, 0b000000100001, 0b100000100001,
+                             0b000000100001, 0b000000100001, 0b100000100001, 0b000000100001};
+  constexpr u32 expected[] = {0, 0, 0, 0b000001, 0, 0b100000, 0, 0};
+
+  for (auto i = 0; i < 8; ++i) {
+    if (counter.update(samples[i]) != expected[i]) {
+      return false;
+    }
+  }
+
+  // the remaining pins of the port, changing at once, are accepted together
+  return counter.stable == 0b100001 && feed(counter, 0xFFF, 3) == 0 && counter.update(0xFFF) == 0xFDE
+         && counter.stable == 0xFFF;
+}
+
+static_assert(accepts_after_four_samples(), "vertical counter does not accept a change after exactly four samples");
+static_assert(restarts_after_glitch(), "vertical counter does not start over after a glitch");
+static_assert(counts_bits_independently(), "vertical counters of different pins interfere");
@@ -0,0 +1,7 @@
+describe 'debouncer vertical counters', host: true do
+  subject(:program) { HostProgram.new 'spec/host/debounce/checks.cpp' }
+
+  it 'accepts a change after four agreeing samples, restarts after a glitch and keeps pins apart' do
+    expect(program.compile).to have_attributes(output: '', success?: true)
+  end
+end
@@ -0,0 +1,128 @@
+#include <cstdlib>
+
+#include <rtl/math/divide.hpp>
+
+#include "host_checks.hpp"
+
+using rtl::i32;
+using rtl::i64;
+using rtl::u32;
+using rtl::u64;
+
+static_assert(rtl::divmod(u32{100}, u32{7}).quotient == 14);
+static_assert(rtl::divmod(u64{1} << 40, u64{3}).remainder == 1);
+static_assert(rtl::divide<10>(u32{0xFFFFFFFF}) == 429496729);
+
+// @brief Deterministic pseudo-random 64-bit values.
+auto next() {
+  static auto state = u64{0x9E3779B97F4A7C15};
+
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+
+  return state;
+}
+
+// @brief Pseudo-random value of a random width, so that every magnitude and thus every path of the kernels is hit.
+template <typename T> auto sample() {
+  using U = std::make_unsigned_t<T>;
+
+  auto width = next() % (sizeof(T) * 8) + 1;
+  auto value = static_cast<U>(next() >> (64 - width));
+
+  return static_cast<T>((next() % 2 == 0) ? value : U{0} - value);
+}
+
+template <typename T> auto check_divmod(T n, T d) {
+  auto result = rtl::divmod(n, d);
+
+  if (d == 0) {
+    CHECK(result.quotient == 0);
+    CHECK(result.remainder == n);
+  } else if (std::is_signed<T>::value && n == std::numeric_limits<T>::min() && d == T(-1)) {
+    // the quotient wraps around, as with the divide instructions of other ARM processors
+    CHECK(result.quotient == std::numeric_limits<T>::min());
+    CHECK(result.remainder == 0);
+  } else {
+    CHECK(result.quotient == n / d);
+    CHECK(result.remainder == n % d);
+  }
+}
+
+template <typename T> auto check_edges() {
+  using limits = std::numeric_limits<T>;
+  using U = std::make_unsigned_t<T>;
+
+  T edges[3 * sizeof(T) * 8 + 8] = {T{0}, T{1}, T(2), T(3), limits::max(), T(limits::max() - 1), limits::min(),
+                                    T(limits::min() + 1)};
+  auto count = std::size_t{8};
+
+  for (auto bit = std::size_t{0}; bit < sizeof(T) * 8; ++bit) {
+    auto power = U{1} << bit;
+
+    edges[count++] = static_cast<T>(power);
+    edges[count++] = static_cast<T>(power - 1);
+    edges[count++] = static_cast<T>(power + 1);
+  }
+
+  for (auto n : edges) {
+    for (auto d : edges) {
+      check_divmod(n, d);
+
+      if (std::is_signed<T>::value) {
+        check_divmod(n, static_cast<T>(U{0} - static_cast<U>(d)));
+        check_divmod(static_cast<T>(U{0} - static_cast<U>(n)), d);
+      }
+    }
+  }
+}
+
+template <typename T> auto check_random() {
+  for (auto i = 0; i < 200000; ++i) {
+    check_divmod(sample<T>(), sample<T>());
+  }
+}
+
+auto check_multiply() {
+  for (auto i = 0; i < 100000; ++i) {
+    auto a = sample<u64>();
+    auto b = sample<u64>();
+
+    CHECK(rtl::multiply(a, b) == a * b);
+  }
+}
+
+template <u32 d> auto check_constant_divisor() {
+  for (auto n : {u32{0}, u32{1}, d - 1, d, d + 1, u32{0x7FFFFFFF}, u32{0x80000000}, u32{0xFFFFFFFE}, u32{0xFFFFFFFF}}) {
+    CHECK(rtl::divide<d>(n) == n / d);
+  }
+
+  for (auto i = 0; i < 20000; ++i) {
+    auto n = sample<u32>();
+    CHECK(rtl::divide<d>(n) == n / d);
+  }
+}
+
+template <u32... d> auto check_constant_divisors() {
+  (check_constant_divisor<d>(), ...);
+}
+
+int main() {
+  check_edges<u32>();
+  check_edges<i32>();
+  check_edges<u64>();
+  check_edges<i64>();
+
+  check_random<u32>();
+  check_random<i32>();
+  check_random<u64>();
+  check_random<i64>();
+
+  check_multiply();
+
+  check_constant_divisors<1, 2, 3, 5, 6, 7, 10, 12, 25, 60, 100, 641, 1000, 3600, 1000000, 12345679, 0x10000,
+                          0x7FFFFFFF, 0x80000000, 0x80000001, 0xAAAAAAAB, 0xFFFFFFFF>();
+
+  return spec::host::report();
+}
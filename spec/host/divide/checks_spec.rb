@@ -0,0 +1,7 @@
+describe 'integer division routines', host: true do
+  subject(:program) { HostProgram.new 'spec/host/divide/checks.cpp' }
+
+  it 'passes every check' do
+    expect(program.run).to have_attributes(output: '', success?: true)
+  end
+end
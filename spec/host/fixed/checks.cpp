@@ -0,0 +1,134 @@
+#include <cstdlib>
+
+#include <rtl/math/fixed.hpp>
+#include <rtl/units.hpp>
+
+#include "host_checks.hpp"
+
+using rtl::i32;
+using rtl::i64;
+using rtl::u32;
+
+static_assert(std::is_same<rtl::fixed<3, 4>::value_type, rtl::i8>::value);
+static_assert(std::is_same<rtl::fixed<7, 8>::value_type, rtl::i16>::value);
+static_assert(std::is_same<rtl::fixed<8, 8>::value_type, rtl::i32>::value);
+
+static_assert((rtl::fixed<10, 20>::max() + rtl::fixed<10, 20>::max()).value() == 1073741823);
+static_assert((rtl::fixed<10, 20>::min() - rtl::fixed<10, 20>::max()).value() == -1073741824);
+static_assert((rtl::q31::min() / -1).value() == std::numeric_limits<i32>::max());
+static_assert((rtl::q15::min() / -1).value() == std::numeric_limits<rtl::i16>::max());
+static_assert((rtl::q7::min() / rtl::i8{-1}).value() == std::numeric_limits<rtl::i8>::max());
+static_assert((rtl::q31::min() / 0x80000000u).value() == -1);
+static_assert((rtl::q31::max() / 0xFFFFFFFFu).value() == 0);
+static_assert((rtl::fixed<15, 16>{-6} / 0x80000000u).value() == 0);
+static_assert((rtl::fixed<15, 16>{-1} * 0x80000000u) == rtl::fixed<15, 16>::min());
+
+// @brief Value only known at runtime, so that the computation is not constant folded.
+template <typename T> auto runtime(T value) {
+  volatile auto opaque = value;
+  return opaque;
+}
+
+template <typename Fixed> auto saturate(__int128 x) {
+  return static_cast<i64>((x < Fixed::min_raw) ? Fixed::min_raw : (x > Fixed::max_raw) ? Fixed::max_raw : x);
+}
+
+// @brief Deterministic sample of the raw values of a format, with its edges.
+template <typename Fixed> auto samples() {
+  static i64 values[64];
+  auto count = std::size_t{0};
+
+  for (auto x : {Fixed::min_raw, Fixed::min_raw + 1, i64{-2}, i64{-1}, i64{0}, i64{1}, i64{2}, Fixed::max_raw - 1,
+                 Fixed::max_raw, Fixed::max_raw / 2, Fixed::max_raw / 2 + 1, Fixed::min_raw / 2 - 1}) {
+    values[count++] = x;
+  }
+
+  auto state = u32{12345};
+
+  while (count < 64) {
+    state = state * 1664525 + 1013904223;
+    values[count++] = Fixed::min_raw + static_cast<i64>(state % static_cast<u32>(Fixed::max_raw - Fixed::min_raw));
+  }
+
+  return values;
+}
+
+// @brief Checks every operator of a format against saturated 128-bit arithmetic on its raw values.
+template <typename Fixed> auto check_format() {
+  constexpr auto F = Fixed::fractional_bits;
+  auto values = samples<Fixed>();
+
+  for (auto i = 0; i < 64; ++i) {
+    for (auto j = 0; j < 64; ++j) {
+      auto a = values[i];
+      auto b = values[j];
+      auto x = Fixed::from_raw(runtime(a));
+      auto y = Fixed::from_raw(runtime(b));
+
+      CHECK((x + y).value() == saturate<Fixed>(__int128{a} + b));
+      CHECK((x - y).value() == saturate<Fixed>(__int128{a} - b));
+      CHECK((x * y).value() == saturate<Fixed>((__int128{a} * b + (__int128{1} << F >> 1)) >> F));
+
+      if (b != 0) {
+        CHECK((x / y).value() == saturate<Fixed>(__int128{a} * (__int128{1} << F) / b));
+      } else {
+        CHECK((x / y).value() == ((a < 0) ? Fixed::min_raw : (a > 0) ? Fixed::max_raw : 0));
+      }
+    }
+
+    auto x = Fixed::from_raw(runtime(values[i]));
+
+    CHECK((-x).value() == saturate<Fixed>(-__int128{values[i]}));
+
+    for (auto divisor : {i32{-1}, i32{1}, i32{-3}, i32{7}, std::numeric_limits<i32>::min(),
+                         std::numeric_limits<i32>::max()}) {
+      CHECK((x / runtime(divisor)).value() == saturate<Fixed>(__int128{values[i]} / divisor));
+      CHECK((x * runtime(divisor)).value() == saturate<Fixed>(__int128{values[i]} * divisor));
+    }
+
+    for (auto divisor : {u32{1}, u32{3}, u32{0x7FFFFFFF}, u32{0x80000000}, u32{0x80000001}, u32{0xFFFFFFFF}}) {
+      CHECK((x / runtime(divisor)).value() == saturate<Fixed>(__int128{values[i]} / divisor));
+      CHECK((x * runtime(divisor)).value() == saturate<Fixed>(__int128{values[i]} * divisor));
+    }
+
+    // divisors around the largest magnitude, where the quotients leave the 32-bit division path
+    constexpr auto largest = u32{1} << (Fixed::integer_bits + F);
+
+    for (auto divisor : {largest - 1, largest, largest + 1}) {
+      CHECK((x / runtime(divisor)).value() == saturate<Fixed>(__int128{values[i]} / divisor));
+    }
+
+    CHECK((x / runtime(static_cast<i32>(Fixed::min_raw))).value() == saturate<Fixed>(__int128{values[i]}
+                                                                                      / Fixed::min_raw));
+    CHECK((x / runtime(rtl::u8{200})).value() == saturate<Fixed>(__int128{values[i]} / 200));
+    CHECK((x * runtime(rtl::i16{-300})).value() == saturate<Fixed>(__int128{values[i]} * -300));
+  }
+}
+
+// @brief Checks fixed-point values can be the value type of quantities, converting between units through the integer
+//        operators.
+auto check_quantities() {
+  using seconds = rtl::fixed<15, 16>;
+
+  auto duration = rtl::quantity<seconds, rtl::millisecond>{seconds{runtime(1500)}};
+
+  CHECK(duration.as<rtl::second>() == seconds{1.5});
+  CHECK(duration.as<rtl::microsecond>() == seconds{1500000});
+  CHECK((duration + duration).as<rtl::second>() == seconds{3});
+}
+
+int main() {
+  check_format<rtl::q7>();
+  check_format<rtl::fixed<3, 4>>();
+  check_format<rtl::q15>();
+  check_format<rtl::fixed<7, 8>>();
+  check_format<rtl::fixed<8, 8>>();
+  check_format<rtl::fixed<10, 20>>();
+  check_format<rtl::fixed<15, 15>>();
+  check_format<rtl::fixed<15, 16>>();
+  check_format<rtl::q31>();
+  check_format<rtl::fixed<31, 0>>();
+  check_quantities();
+
+  return spec::host::report();
+}
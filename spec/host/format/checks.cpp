@@ -0,0 +1,87 @@
+#include <cstdlib>
+#include <cstring>
+
+#include <rtl/waitable.hpp>
+#include <sys/format.hpp>
+
+#include "host_checks.hpp"
+#include "simple_json.hpp"
+
+static_assert(sys::max_format_length<rtl::i32> == 11);
+static_assert(sys::max_format_length<rtl::u16, rtl::i64> == 5 + 20);
+static_assert(sys::max_format_length<rtl::i32, const char*> == 0);
+
+auto check_length() {
+  CHECK(sys::format_length(std::pair{"", rtl::i32{0}}) == 1);
+  CHECK(sys::format_length(std::pair{"", std::numeric_limits<rtl::i32>::min()}) == 11);
+  CHECK(sys::format_length(std::pair{"", "abc"}, std::pair{"", rtl::i64{-42}}) == 6);
+}
+
+auto check_fits() {
+  char buffer[8];
+  auto result = sys::format_to(buffer, sizeof(buffer), std::pair{"", "ab"}, std::pair{"", rtl::i32{-5}});
+
+  CHECK(result.length == 4);
+  CHECK(!result.truncated);
+  CHECK(std::strcmp(buffer, "ab-5") == 0);
+}
+
+auto check_truncation() {
+  char buffer[4];
+  auto result = sys::format_to(buffer, sizeof(buffer), std::pair{"", "hello"});
+
+  CHECK(result.length == 5);
+  CHECK(result.truncated);
+  CHECK(std::strcmp(buffer, "hel") == 0);
+}
+
+auto check_exact_fit() {
+  char buffer[6];
+  auto result = sys::format_to(buffer, sizeof(buffer), std::pair{"", "hello"});
+
+  CHECK(result.length == 5);
+  CHECK(!result.truncated);
+  CHECK(std::strcmp(buffer, "hello") == 0);
+}
+
+auto check_measure_only() {
+  auto result = sys::format_to(nullptr, 0, std::pair{"", rtl::i64{123456}});
+
+  CHECK(result.length == 6);
+  CHECK(result.truncated);
+}
+
+auto check_array() {
+  char buffer[sys::max_format_length<rtl::i64> + 1];
+  auto result = sys::format_to(buffer, std::pair{"", std::numeric_limits<rtl::i64>::min()});
+
+  CHECK(result.length == 20);
+  CHECK(std::strcmp(buffer, "-9223372036854775808") == 0);
+}
+
+auto check_json_number_size() {
+  CHECK(spec::json::number{0}.size() == 1);
+  CHECK(spec::json::number{-10}.size() == 3);
+  CHECK(spec::json::number{std::numeric_limits<rtl::i64>::min()}.size() == 20);
+}
+
+auto check_json_number() {
+  char buffer[sys::max_format_length<rtl::i64> + 1];
+  auto number = spec::json::number{-1234};
+
+  CHECK(number.dump(buffer, sizeof(buffer)) == buffer + number.size());
+  CHECK(std::strcmp(buffer, "-1234") == 0);
+}
+
+int main() {
+  check_length();
+  check_fits();
+  check_truncation();
+  check_exact_fit();
+  check_measure_only();
+  check_array();
+  check_json_number_size();
+  check_json_number();
+
+  return spec::host::report();
+}
@@ -0,0 +1,7 @@
+describe 'sys::format', host: true do
+  subject(:program) { HostProgram.new 'spec/host/format/checks.cpp' }
+
+  it 'passes every check' do
+    expect(program.run).to have_attributes(output: '', success?: true)
+  end
+end
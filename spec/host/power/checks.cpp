@@ -0,0 +1,90 @@
+#include <cstdlib>
+
+#include <rtl/units.hpp>
+
+#include "host_checks.hpp"
+
+using rtl::i32;
+using rtl::u16;
+using rtl::u32;
+
+static_assert(rtl::ipow(3, 0) == 1);
+static_assert(rtl::ipow(-3, 3) == -27);
+static_assert(rtl::ipow(u32{2}, 31) == u32{1} << 31);
+static_assert(rtl::ipow(i32{2}, 31) == std::numeric_limits<i32>::min());
+static_assert(rtl::ipow(u16{65535}, 2) == 1);
+
+static_assert(rtl::isqrt(0) == 0);
+static_assert(rtl::isqrt(15) == 3);
+static_assert(rtl::isqrt(16) == 4);
+static_assert(rtl::isqrt(std::numeric_limits<u32>::max()) == 65535);
+static_assert(rtl::iroot<3>(26) == 2);
+static_assert(rtl::iroot<3>(27) == 3);
+
+// @brief Value only known at runtime, so that the computation is not constant folded.
+template <typename T> auto runtime(T value) {
+  volatile auto opaque = value;
+  return opaque;
+}
+
+// @brief Returns the value of a quantity in its own unit.
+template <typename T, typename Dimension> auto raw(rtl::quantity<T, Dimension> q) {
+  return q.template as<Dimension>();
+}
+
+// @brief Checks ipow wraps around exactly like repeated multiplication modulo 2^N.
+template <typename T> auto check_wrap(T base) {
+  using U = std::make_unsigned_t<T>;
+
+  for (auto exponent = 0u; exponent < 40; ++exponent) {
+    auto expected = U{1};
+
+    for (auto i = 0u; i < exponent; ++i) {
+      expected = static_cast<U>(static_cast<rtl::u64>(expected) * static_cast<U>(base));
+    }
+
+    CHECK(rtl::ipow(runtime(base), exponent) == static_cast<T>(expected));
+  }
+}
+
+auto check_quantities() {
+  auto side = rtl::quantity<u32, rtl::meter>{runtime(u32{12})};
+  auto area = rtl::pow<2>(side);
+
+  CHECK(raw(rtl::sqrt(area)) == 12);
+  CHECK(raw(rtl::pow<3>(side)) == 1728);
+  CHECK(raw(rtl::pow<std::ratio<3, 2>>(rtl::quantity<u32, rtl::meter>{runtime(u32{16})})) == 64);
+
+  // perfect squares, and the integers on either side of them, which round down
+  for (auto root = u32{0}; root < 65536; root += 97) {
+    auto square = root * root;
+
+    CHECK(raw(rtl::sqrt(rtl::quantity<u32, rtl::meter>{runtime(square)})) == root);
+
+    if (square != 0) {
+      CHECK(raw(rtl::sqrt(rtl::quantity<u32, rtl::meter>{runtime(square - 1)})) == root - 1);
+    }
+
+    CHECK(raw(rtl::sqrt(rtl::quantity<u32, rtl::meter>{runtime(square + 1)})) == (root == 0 ? 1 : root));
+  }
+
+  // odd roots keep the sign of negative values
+  CHECK(raw(rtl::pow<std::ratio<1, 3>>(rtl::quantity<i32, rtl::meter>{runtime(i32{-27})})) == -3);
+  CHECK(raw(rtl::pow<std::ratio<1, 3>>(rtl::quantity<i32, rtl::meter>{runtime(i32{-28})})) == -3);
+  CHECK(raw(rtl::pow<std::ratio<1, 3>>(rtl::quantity<i32, rtl::meter>{runtime(i32{-26})})) == -2);
+
+  // the scale of the unit is a perfect square
+  CHECK(raw(rtl::sqrt(rtl::pow<2>(rtl::quantity<u32, rtl::kilometer>{runtime(u32{3})}))) == 3);
+}
+
+int main() {
+  check_wrap(i32{3});
+  check_wrap(i32{-7});
+  check_wrap(i32{65535});
+  check_wrap(u32{0xFFFFFFFF});
+  check_wrap(u16{65535});
+  check_wrap(rtl::i8{-128});
+  check_quantities();
+
+  return spec::host::report();
+}
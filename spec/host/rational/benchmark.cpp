@@ -0,0 +1,58 @@
+#include <cstdlib>
+#include <chrono>
+
+#include <rtl/math/rational.hpp>
+
+#include "host_checks.hpp"
+#include "euclid_rational.hpp"
+
+using rtl::i32;
+using rtl::u32;
+
+using euclid = spec::euclid_rational<rtl::r32, rtl::rational_mode::best>;
+
+constexpr auto iterations = 1000000;
+
+// @brief Returns the nanoseconds per call of a kernel, whose operands are laundered through volatile variables so
+//        that the work cannot be hoisted out of the loop.
+template <typename F> auto benchmark(rtl::r32 lhs, rtl::r32 rhs, rtl::r32& result, F kernel) {
+  volatile auto lhs_numerator = lhs.numerator();
+  volatile auto rhs_numerator = rhs.numerator();
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (auto i = 0; i < iterations; ++i) {
+    result = kernel(rtl::r32{lhs_numerator, lhs.denominator()}, rtl::r32{rhs_numerator, rhs.denominator()});
+  }
+
+  auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+  return elapsed.count() / iterations;
+}
+
+template <char op, typename F> auto compare(const char* name, rtl::r32 lhs, rtl::r32 rhs, F kernel) {
+  auto binary_result = rtl::r32{};
+  auto euclid_result = rtl::r32{};
+
+  auto binary = benchmark(lhs, rhs, binary_result, kernel);
+  auto baseline = benchmark(lhs, rhs, euclid_result, [](auto a, auto b) { return euclid::apply(op, a, b); });
+
+  CHECK(binary_result.numerator() == euclid_result.numerator());
+  CHECK(binary_result.denominator() == euclid_result.denominator());
+
+  std::printf("r32 %s: %.1f ns per operation with the binary GCD, %.1f ns with the Euclidean GCD\n",
+              name, binary, baseline);
+}
+
+int main() {
+  auto a = rtl::r32{1000000007, 998244353};
+  auto b = rtl::r32{998244353, 1000000009};
+  auto c = rtl::r32{-355, 113};
+  auto d = rtl::r32{22, 7};
+
+  compare<'+'>("addition", a, b, [](auto x, auto y) { return rtl::r32{x + y}; });
+  compare<'-'>("subtraction", c, d, [](auto x, auto y) { return rtl::r32{x - y}; });
+  compare<'*'>("multiplication", a, b, [](auto x, auto y) { return rtl::r32{x * y}; });
+  compare<'/'>("division", a, b, [](auto x, auto y) { return rtl::r32{x / y}; });
+
+  return spec::host::report();
+}
@@ -0,0 +1,12 @@
+describe 'rtl::r32 normalization', host: true do
+  subject(:program) { HostProgram.new 'spec/host/rational/benchmark.cpp' }
+
+  # The times are reported rather than checked against a threshold. The host
+  # divides in hardware, so unlike the Cortex-M0 it favours the Euclidean GCD;
+  # the target figures come from the arithmetic board.
+  it 'reports the time per operation against the Euclidean GCD' do
+    result = program.run
+    puts result.output
+    expect(result.success?).to be true
+  end
+end
@@ -0,0 +1,97 @@
+#include <cstdlib>
+
+#include <rtl/math/rational.hpp>
+
+#include "host_checks.hpp"
+#include "euclid_rational.hpp"
+
+using rtl::i16;
+using rtl::i32;
+using rtl::u16;
+using rtl::u32;
+
+static_assert(rtl::exact(rtl::r16{1, 2} + rtl::r16{1, 3}) == rtl::r16{5, 6});
+static_assert(rtl::fast(rtl::r16{1, 2} * rtl::r16{2, 3}) == rtl::r16{1, 3});
+static_assert(rtl::r16{rtl::r16{1, 2} / rtl::r16{-1, 4}} == rtl::r16{-2, 1});
+
+// @brief The operators of the baseline, which normalized after every operator in the mode of the rational type with
+//        the Euclidean GCD.
+template <rtl::rational_mode mode> using reference = spec::euclid_rational<rtl::r16, mode>;
+
+// @brief Returns whether two rationals have exactly the same numerator and denominator.
+auto same(rtl::r16 value, rtl::r16 expected) {
+  return value.numerator() == expected.numerator() && value.denominator() == expected.denominator();
+}
+
+template <char op, typename Fn> auto check_operator(rtl::r16 lhs, rtl::r16 rhs, Fn&& expression) {
+  auto best = reference<rtl::rational_mode::best>::apply(op, lhs, rhs);
+  auto fast = reference<rtl::rational_mode::fast>::apply(op, lhs, rhs);
+
+  CHECK(same(rtl::exact(expression(lhs, rhs)), best));
+  CHECK(same(rtl::fast(expression(lhs, rhs)), fast));
+  CHECK(same(rtl::r16{expression(lhs, rhs)}, best));
+  CHECK(same(rtl::q16{expression(rtl::q16{lhs}, rtl::q16{rhs})}, fast));
+}
+
+// @brief Checks every single operator against the old operators, over operands whose double-width intermediates
+//        cannot overflow; some results fit the narrow type unreduced, and the others are normalized.
+auto check_single_operators() {
+  auto state = u32{12345};
+  auto next = [&](u32 limit) {
+    state = state * 1664525 + 1013904223;
+    return (state >> 8) % limit;
+  };
+
+  for (auto i = 0; i < 200000; ++i) {
+    // every other pair of operands is small, so that most of their results fit unreduced
+    auto range = (i % 2 == 0) ? u32{32768} : u32{256};
+
+    auto lhs = rtl::r16{static_cast<i16>(static_cast<i32>(next(range)) - static_cast<i32>(range / 2)),
+                        static_cast<u16>(next(range - 1) + 1)};
+    auto rhs = rtl::r16{static_cast<i16>(static_cast<i32>(next(range)) - static_cast<i32>(range / 2)),
+                        static_cast<u16>(next(range - 1) + 1)};
+
+    check_operator<'+'>(lhs, rhs, [](auto a, auto b) { return a + b; });
+    check_operator<'-'>(lhs, rhs, [](auto a, auto b) { return a - b; });
+    check_operator<'*'>(lhs, rhs, [](auto a, auto b) { return a * b; });
+
+    // the old operators wrapped negative divisors into the unsigned denominator
+    if (rhs.numerator() > 0) {
+      check_operator<'/'>(lhs, rhs, [](auto a, auto b) { return a / b; });
+    }
+  }
+}
+
+// @brief Checks that compound expressions evaluated by rtl::exact are exact whenever their result is representable.
+auto check_expressions() {
+  auto x = rtl::r16{355, 113};
+  auto y = rtl::r16{-22, 7};
+
+  CHECK(rtl::exact(x + (y - x)) == y);
+  CHECK(rtl::exact((x * y) / y) == x);
+  CHECK(rtl::exact(x / y * y) == x);
+  CHECK(rtl::exact(x - x) == rtl::r16{i16{0}});
+  CHECK(rtl::exact(x * 2 - x) == x);
+
+  // rtl::fast is only exact while the unreduced results fit
+  CHECK(rtl::fast(rtl::r16{1, 2} + rtl::r16{1, 4} - rtl::r16{1, 8}) == rtl::r16{5, 8});
+
+  // results are in lowest terms under rtl::exact, and unreduced under rtl::fast while they fit
+  CHECK(same(rtl::exact(rtl::r16{1, 2} + rtl::r16{1, 6}), {2, 3}));
+  CHECK(same(rtl::fast(rtl::r16{1, 2} + rtl::r16{1, 6}), {8, 12}));
+
+  // moving the sign of a negative divisor to the numerator
+  CHECK(same(rtl::exact(rtl::r16{3, 4} / rtl::r16{-1, 2}), {-3, 2}));
+
+  // an expression held in a variable keeps its operands alive
+  auto sum = x + y;
+  x = rtl::r16{i16{0}};
+  CHECK(rtl::exact(sum) == rtl::r16{-1, 791});
+}
+
+int main() {
+  check_single_operators();
+  check_expressions();
+
+  return spec::host::report();
+}
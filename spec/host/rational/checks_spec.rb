@@ -0,0 +1,7 @@
+describe 'rtl::r16 and rtl::q16', host: true do
+  subject(:program) { HostProgram.new 'spec/host/rational/checks.cpp' }
+
+  it 'passes every check' do
+    expect(program.run).to have_attributes(output: '', success?: true)
+  end
+end
@@ -0,0 +1,94 @@
+#include <cstdlib>
+
+#include <rtl/ring.hpp>
+
+#include "host_checks.hpp"
+
+using rtl::u32;
+
+auto check_empty() {
+  auto ring = rtl::ring<u32, 4>{};
+  u32 out[4] = {};
+
+  CHECK(ring.empty());
+  CHECK(ring.size() == 0);
+  CHECK(ring.pop(out, 4) == 0);
+  CHECK(ring.empty());
+}
+
+auto check_full() {
+  auto ring = rtl::ring<u32, 4>{};
+  u32 out[8] = {};
+
+  for (auto i = u32{0}; i < 4; ++i) {
+    CHECK(ring.push(i));
+    CHECK(ring.size() == i + 1);
+  }
+
+  // a full ring refuses new items and keeps the old ones
+  CHECK(!ring.push(99));
+  CHECK(ring.size() == 4);
+
+  CHECK(ring.pop(out, 8) == 4);
+
+  for (auto i = u32{0}; i < 4; ++i) {
+    CHECK(out[i] == i);
+  }
+
+  CHECK(ring.empty());
+  CHECK(ring.push(4));
+}
+
+auto check_partial_pop() {
+  auto ring = rtl::ring<u32, 4>{};
+  u32 out[4] = {};
+
+  CHECK(ring.push(1));
+  CHECK(ring.push(2));
+  CHECK(ring.push(3));
+
+  CHECK(ring.pop(out, 2) == 2);
+  CHECK(out[0] == 1 && out[1] == 2);
+  CHECK(ring.size() == 1);
+
+  CHECK(ring.pop(out, 0) == 0);
+  CHECK(ring.pop(out, 4) == 1);
+  CHECK(out[0] == 3);
+}
+
+// @brief Pushes and pops batches of varying sizes, so that the items straddle the end of the storage in every way.
+auto check_wrap_around() {
+  auto ring = rtl::ring<u32, 8>{};
+  u32 out[8] = {};
+  auto pushed = u32{0};
+  auto popped = u32{0};
+
+  for (auto round = u32{0}; round < 1000; ++round) {
+    for (auto i = u32{0}; i < round % 9; ++i) {
+      if (ring.push(pushed)) {
+        ++pushed;
+      } else {
+        CHECK(ring.size() == 8);
+      }
+    }
+
+    CHECK(ring.size() == pushed - popped);
+
+    auto count = ring.pop(out, (round * 5) % 9);
+
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      CHECK(out[i] == popped++);
+    }
+  }
+
+  CHECK(pushed > 1000);
+}
+
+int main() {
+  check_empty();
+  check_full();
+  check_partial_pop();
+  check_wrap_around();
+
+  return spec::host::report();
+}
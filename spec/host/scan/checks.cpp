@@ -0,0 +1,92 @@
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/scan.hpp>
+
+#include "host_checks.hpp"
+
+// feeds the input one byte at a time, exactly as the UART receive interrupt would
+template <typename T> auto feed(T fiber, const char* input) {
+  for (; *input != '\0'; ++input) {
+    auto status = fiber(static_cast<rtl::u8>(*input));
+
+    if (status != rtl::waitable::status::pending) {
+      return status;
+    }
+  }
+
+  return rtl::waitable::status::pending;
+}
+
+auto check_three_fields() {
+  char name[8] = {};
+  auto a = rtl::i32{0};
+  auto b = rtl::u32{0};
+
+  CHECK(feed(sys::scan(std::pair{" ", sys::token(name)}, std::pair{" ", &a}, std::pair{"\n", sys::hex(&b)}),
+             "set -12 0x1F\n") == rtl::waitable::status::complete);
+  CHECK(std::strcmp(name, "set") == 0);
+  CHECK(a == -12);
+  CHECK(b == 0x1F);
+}
+
+auto check_many_fields() {
+  char name[8] = {};
+  rtl::i32 values[5] = {};
+
+  auto status = feed(sys::scan(std::pair{" ", sys::token(name)}, std::pair{",", &values[0]}, std::pair{",", &values[1]},
+                               std::pair{",", &values[2]}, std::pair{",", sys::fixed<2>(&values[3])},
+                               std::pair{"\n", &values[4]}),
+                     "pid 1,-2,3,4.5,6\n");
+
+  CHECK(status == rtl::waitable::status::complete);
+  CHECK(std::strcmp(name, "pid") == 0);
+  CHECK(values[0] == 1);
+  CHECK(values[1] == -2);
+  CHECK(values[2] == 3);
+  CHECK(values[3] == 450);
+  CHECK(values[4] == 6);
+}
+
+auto check_many_fields_stop_on_terminator() {
+  rtl::i32 values[4] = {};
+
+  auto status = feed(sys::scan(std::pair{" ", &values[0]}, std::pair{" ", &values[1]}, std::pair{" ", &values[2]},
+                               std::pair{"\n", &values[3]}),
+                     "1 2 3 4\nignored");
+
+  CHECK(status == rtl::waitable::status::complete);
+  CHECK(values[3] == 4);
+}
+
+auto check_many_fields_fail_late() {
+  rtl::i32 values[4] = {};
+
+  auto status = feed(sys::scan(std::pair{" ", &values[0]}, std::pair{" ", &values[1]}, std::pair{" ", &values[2]},
+                               std::pair{"\n", &values[3]}),
+                     "1 2 3 x\n");
+
+  CHECK(status == rtl::waitable::status::failed);
+  CHECK(values[2] == 3);
+  CHECK(values[3] == 0);
+}
+
+auto check_many_fields_pending() {
+  rtl::i32 values[4] = {};
+
+  auto status = feed(sys::scan(std::pair{" ", &values[0]}, std::pair{" ", &values[1]}, std::pair{" ", &values[2]},
+                               std::pair{"\n", &values[3]}),
+                     "1 2 3 4");
+
+  CHECK(status == rtl::waitable::status::pending);
+}
+
+int main() {
+  check_three_fields();
+  check_many_fields();
+  check_many_fields_stop_on_terminator();
+  check_many_fields_fail_late();
+  check_many_fields_pending();
+
+  return spec::host::report();
+}
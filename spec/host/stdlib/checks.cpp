@@ -0,0 +1,137 @@
+#include <cstdlib>
+
+#include <rtl/base.hpp>
+
+#include "host_checks.hpp"
+
+// built together with the memory routines of the runtime, which replace those of the host C library
+
+extern "C" void* memcpy(void* dest, const void* src, std::size_t n);
+extern "C" void* memmove(void* dest, const void* src, std::size_t n);
+extern "C" void* memset(void* dest, int c, std::size_t n);
+extern "C" int memcmp(const void* a, const void* b, std::size_t n);
+extern "C" std::size_t strlen(const char* str);
+
+namespace {
+
+using rtl::u8;
+
+// @brief Buffers span several words and both ends of the word loops, and are aligned so that offsets are exact.
+constexpr auto size = std::size_t{96};
+constexpr auto max_length = std::size_t{72};
+
+alignas(16) u8 buffer[size];
+alignas(16) u8 other[size];
+
+auto pattern(std::size_t index) {
+  return static_cast<u8>(index * 7 + 1);
+}
+
+auto reset() {
+  for (auto i = std::size_t{0}; i < size; ++i) {
+    buffer[i] = pattern(i);
+    other[i] = static_cast<u8>(~pattern(i));
+  }
+}
+
+// @brief Returns whether \p actual holds \p expected at every index, reporting the first mismatch.
+template <typename Fn> auto matches(const u8* actual, Fn&& expected) {
+  for (auto i = std::size_t{0}; i < size; ++i) {
+    if (actual[i] != expected(i)) {
+      std::printf("  mismatch at byte %zu: %u instead of %u\n", i, unsigned{actual[i]}, unsigned{expected(i)});
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// @brief Copies between separate buffers at every pair of word offsets, for every length.
+auto check_memcpy() {
+  for (auto dest = std::size_t{0}; dest < 4; ++dest) {
+    for (auto src = std::size_t{0}; src < 4; ++src) {
+      for (auto n = std::size_t{0}; n <= max_length; ++n) {
+        reset();
+
+        CHECK(memcpy(other + dest, buffer + src, n) == other + dest);
+        CHECK(matches(other, [&](std::size_t i) {
+          return (i >= dest && i < dest + n) ? pattern(i - dest + src) : static_cast<u8>(~pattern(i));
+        }));
+      }
+    }
+  }
+}
+
+// @brief Moves within one buffer, with overlaps in both directions at every relative offset up to two words.
+auto check_memmove() {
+  for (auto dest = std::size_t{0}; dest < 12; ++dest) {
+    for (auto src = std::size_t{0}; src < 12; ++src) {
+      for (auto n = std::size_t{0}; n <= max_length; ++n) {
+        reset();
+
+        CHECK(memmove(buffer + dest, buffer + src, n) == buffer + dest);
+        CHECK(matches(buffer, [&](std::size_t i) {
+          return (i >= dest && i < dest + n) ? pattern(i - dest + src) : pattern(i);
+        }));
+      }
+    }
+  }
+}
+
+auto check_memset() {
+  for (auto dest = std::size_t{0}; dest < 4; ++dest) {
+    for (auto n = std::size_t{0}; n <= max_length; ++n) {
+      reset();
+
+      CHECK(memset(buffer + dest, 0x1A5, n) == buffer + dest);
+      CHECK(matches(buffer, [&](std::size_t i) { return (i >= dest && i < dest + n) ? u8{0xA5} : pattern(i); }));
+    }
+  }
+}
+
+// @brief Compares equal buffers with a single differing byte at every position, at every pair of word offsets.
+auto check_memcmp() {
+  for (auto lhs = std::size_t{0}; lhs < 4; ++lhs) {
+    for (auto rhs = std::size_t{0}; rhs < 4; ++rhs) {
+      for (auto n = std::size_t{0}; n <= 40; ++n) {
+        for (auto i = std::size_t{0}; i < size; ++i) {
+          buffer[i] = other[i] = 0x55;
+        }
+
+        CHECK(memcmp(buffer + lhs, other + rhs, n) == 0);
+
+        for (auto at = std::size_t{0}; at < n; ++at) {
+          buffer[lhs + at] = 0x56;
+          CHECK(memcmp(buffer + lhs, other + rhs, n) == 1);
+          CHECK(memcmp(other + rhs, buffer + lhs, n) == -1);
+          buffer[lhs + at] = 0x55;
+        }
+      }
+    }
+  }
+}
+
+auto check_strlen() {
+  for (auto start = std::size_t{0}; start < 4; ++start) {
+    for (auto n = std::size_t{0}; n < 40; ++n) {
+      for (auto i = std::size_t{0}; i < size; ++i) {
+        buffer[i] = 0x80 | static_cast<u8>(i);
+      }
+
+      buffer[start + n] = 0;
+      CHECK(strlen(reinterpret_cast<const char*>(buffer + start)) == n);
+    }
+  }
+}
+
+}
+
+int main() {
+  check_memcpy();
+  check_memmove();
+  check_memset();
+  check_memcmp();
+  check_strlen();
+
+  return spec::host::report();
+}
@@ -0,0 +1,7 @@
+describe 'memory routines', host: true do
+  subject(:program) { HostProgram.new 'spec/host/stdlib/checks.cpp', 'src/rtl/cortex-m0/stdlib.cpp' }
+
+  it 'passes every check' do
+    expect(program.run).to have_attributes(output: '', success?: true)
+  end
+end
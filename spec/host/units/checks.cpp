@@ -0,0 +1,97 @@
+#include <cstdlib>
+
+#include <rtl/units.hpp>
+
+#include "host_checks.hpp"
+
+using std::ratio;
+
+template <std::intmax_t num, std::intmax_t den = 1> using unit = rtl::dimension<ratio<num, den>, ratio<0>, ratio<0>,
+                                                                              ratio<1>, ratio<0>, ratio<0>, ratio<0>,
+                                                                              ratio<0>, ratio<0>>;
+
+// the conversion factor from unit<from> to unit<to> is from / to
+static_assert(rtl::conversion_error<unit<1>, unit<1000>> == 0);
+static_assert(rtl::conversion_error<unit<1000>, unit<1>> == 0);
+static_assert(rtl::conversion_error<unit<1>, unit<1024>> == 0);
+static_assert(rtl::conversion_error<unit<3>, unit<2>> == 0);
+static_assert(rtl::conversion_error<unit<1>, unit<7>> == 1);
+static_assert(rtl::conversion_error<unit<999999999>, unit<1000000000>> == 1);
+
+static_assert(rtl::detail::folds_exactly<ratio<1, 1000>>());
+static_assert(!rtl::detail::folds_exactly<ratio<1, 7>>());
+static_assert(!rtl::detail::folds_exactly<ratio<10000000000>>());
+
+// scale factors beyond 32 bits are not folded, but still convert
+static_assert(rtl::quantity<rtl::u32, unit<10000000000>>{0}.as<unit<1>>() == 0);
+static_assert(rtl::quantity<rtl::i64, unit<10000000000>>{3}.as<unit<1>>() == 30000000000);
+
+// @brief Truncated exact conversion of x by num / den.
+template <typename T> auto reference(T x, std::intmax_t num, std::intmax_t den) {
+  return static_cast<T>(static_cast<__int128>(x) * num / den);
+}
+
+// @brief Deterministic sample of the 32-bit range, with its edges.
+template <typename T, typename Fn> auto for_samples(T limit, Fn&& fn) {
+  const T edges[] = {0, 1, 2, 6, 7, 8, 999, 1000, 1001, 1023, 1024, 1025, static_cast<T>(limit - 1), limit};
+
+  for (auto x : edges) {
+    fn(x);
+
+    if constexpr (std::is_signed<T>::value) {
+      fn(static_cast<T>(-x));
+    }
+  }
+
+  auto state = rtl::u32{12345};
+
+  for (auto i = 0; i < 100000; ++i) {
+    state = state * 1664525 + 1013904223;
+    fn(static_cast<T>(state % (static_cast<rtl::u64>(limit) + 1)));
+
+    if constexpr (std::is_signed<T>::value) {
+      fn(static_cast<T>(-static_cast<T>(state % (static_cast<rtl::u64>(limit) + 1))));
+    }
+  }
+}
+
+template <typename T, std::intmax_t from, std::intmax_t to> auto check_scale(T limit) {
+  using source = unit<from>;
+  using target = unit<to>;
+
+  constexpr auto error = rtl::conversion_error<source, target>;
+  auto mismatches = 0;
+
+  for_samples(limit, [&](T x) {
+    auto q = rtl::quantity<T, source>{x};
+    auto expected = reference(x, from, to);
+
+    auto automatic = q.template as<target>();
+    auto exact = q.template as<target, rtl::conversion::exact>();
+    auto folded = q.template as<target, rtl::conversion::folded>();
+
+    auto deviation = (folded < expected) ? expected - folded : folded - expected;
+
+    if (automatic != expected || exact != expected || static_cast<std::size_t>(deviation) > error) {
+      ++mismatches;
+    }
+  });
+
+  CHECK(mismatches == 0);
+}
+
+int main() {
+  check_scale<rtl::u32, 1, 1000>(std::numeric_limits<rtl::u32>::max());
+  check_scale<rtl::i32, 1, 1000>(std::numeric_limits<rtl::i32>::max());
+  check_scale<rtl::u32, 1000, 1>(std::numeric_limits<rtl::u32>::max() / 1000);
+  check_scale<rtl::u32, 1, 1024>(std::numeric_limits<rtl::u32>::max());
+  check_scale<rtl::u32, 3, 2>(std::numeric_limits<rtl::u32>::max() / 2);
+  check_scale<rtl::i32, 3, 2>(std::numeric_limits<rtl::i32>::max() / 2);
+  check_scale<rtl::u32, 1, 7>(std::numeric_limits<rtl::u32>::max());
+  check_scale<rtl::i32, 1, 7>(std::numeric_limits<rtl::i32>::max());
+  check_scale<rtl::u32, 999999999, 1000000000>(std::numeric_limits<rtl::u32>::max());
+  check_scale<rtl::u32, 1, 60>(std::numeric_limits<rtl::u32>::max());
+  check_scale<rtl::u32, 1000000, 1>(std::numeric_limits<rtl::u32>::max() / 1000000);
+
+  return spec::host::report();
+}
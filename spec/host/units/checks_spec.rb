@@ -0,0 +1,7 @@
+describe 'rtl::quantity conversions', host: true do
+  subject(:program) { HostProgram.new 'spec/host/units/checks.cpp' }
+
+  it 'passes every check' do
+    expect(program.run).to have_attributes(output: '', success?: true)
+  end
+end
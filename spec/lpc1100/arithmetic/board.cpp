@@ -0,0 +1,95 @@
+#define RTL_CORTEX_M0
+
+#include <hal/lpc1100/system.hpp>
+#include <hal/lpc1100/uart.hpp>
+#include <hal/lpc1100/ticks.hpp>
+#include <rtl/assert.hpp>
+#include <rtl/math/rational.hpp>
+
+#include "euclid_rational.hpp"
+#include "simple_json.hpp"
+#include "drivers/json.hpp"
+
+namespace dev = hal::lpc1100;
+namespace json = spec::json;
+
+enum class arithmetic : rtl::u32 {
+  add       = 0,
+  subtract  = 1,
+  multiply  = 2,
+  divide    = 3
+};
+
+struct test_params {
+  arithmetic operation;
+  rtl::i32 lhs_numerator;
+  rtl::u32 lhs_denominator;
+  rtl::i32 rhs_numerator;
+  rtl::u32 rhs_denominator;
+  rtl::u32 iterations;
+  rtl::u32 baseline;
+};
+
+using euclid = spec::euclid_rational<rtl::r32, rtl::rational_mode::best>;
+
+// the operands are laundered through volatile variables so that the work cannot be hoisted out of the loop
+template <typename F> auto benchmark(const test_params& params, F kernel) {
+  volatile auto lhs_numerator = params.lhs_numerator;
+  volatile auto rhs_numerator = params.rhs_numerator;
+
+  auto result = rtl::r32{};
+  auto start = dev::cycle_counter::now();
+
+  for (auto i = rtl::u32{0}; i < params.iterations; ++i) {
+    result = kernel(rtl::r32{lhs_numerator, params.lhs_denominator},
+                       rtl::r32{rhs_numerator, params.rhs_denominator});
+  }
+
+  return std::pair{result, dev::cycle_counter::since(start)};
+}
+
+// runs the kernel, or the operators normalizing with the Euclidean GCD if the baseline is asked for
+template <char op, typename F> auto measure(const test_params& params, F kernel) {
+  if (params.baseline != 0) {
+    return benchmark(params, [](auto lhs, auto rhs) { return euclid::apply(op, lhs, rhs); });
+  }
+
+  return benchmark(params, kernel);
+}
+
+auto run_spec(const test_params& params) {
+  dev::cycle_counter::enable();
+
+  auto [result, cycles] = [&]() {
+    switch (params.operation) {
+      case arithmetic::add:
+        return measure<'+'>(params, [](auto lhs, auto rhs) { return lhs + rhs; });
+      case arithmetic::subtract:
+        return measure<'-'>(params, [](auto lhs, auto rhs) { return lhs - rhs; });
+      case arithmetic::multiply:
+        return measure<'*'>(params, [](auto lhs, auto rhs) { return lhs * rhs; });
+      default:
+        return measure<'/'>(params, [](auto lhs, auto rhs) { return lhs / rhs; });
+    }
+  }();
+
+  return json::object{
+    std::pair{"numerator", result.numerator()},
+    std::pair{"denominator", result.denominator()},
+    std::pair{"cycles", cycles}
+  };
+}
+
+[[noreturn]] void main(const dev::reset_context& context) {
+  auto spec = spec::json_driver<dev::uart0, test_params>{9600_Hz};
+
+  if (context.event == dev::reset_event::assert) {
+    spec.fail(context.assert.message);
+  }
+
+  while (true) {
+    spec.run([&](auto&&... args) {
+      return run_spec(std::forward<decltype(args)>(args)...);
+    });
+  }
+}
@@ -0,0 +1,56 @@
+# Links expected:
+#   device => program upload link to device
+#   main => serial link to device UART0
+
+module LPC1100
+  class Arithmetic
+    def initialize(options, links)
+      @options = options
+      @links = links
+    end
+
+    def upload(program)
+      @links[:device].upload program
+    end
+
+    def response
+      @response ||= Drivers::JSON.new(@links[:main], payload).run
+    end
+
+    private
+
+    def payload
+      Class.new BinaryStruct do
+        layout :operation,        :uint,
+               :lhs_numerator,    :int,
+               :lhs_denominator,  :uint,
+               :rhs_numerator,    :int,
+               :rhs_denominator,  :uint,
+               :iterations,       :uint,
+               :baseline,         :uint
+      end.new(params).bytes
+    end
+
+    def params
+      lhs = @options.fetch(:lhs)
+      rhs = @options.fetch(:rhs)
+
+      @params ||= {
+        operation: OPERATIONS.fetch(@options.fetch(:operation)),
+        lhs_numerator: lhs.numerator,
+        lhs_denominator: lhs.denominator,
+        rhs_numerator: rhs.numerator,
+        rhs_denominator: rhs.denominator,
+        iterations: @options.fetch(:iterations, 1),
+        baseline: @options.fetch(:baseline, false) ? 1 : 0
+      }
+    end
+
+    OPERATIONS = {
+      add:      0,
+      subtract: 1,
+      multiply: 2,
+      divide:   3
+    }.freeze
+  end
+end
@@ -0,0 +1,106 @@
+require_relative 'board'
+
+describe LPC1100::Arithmetic, hardware: true do
+  subject(:board) { described_class.new params, links }
+
+  describe 'rtl::r32' do
+    before { board.upload 'bin/lpc1100-arithmetic-firmware.bin' }
+
+    let(:params) do
+      {
+        operation: operation,
+        lhs: lhs,
+        rhs: rhs,
+        iterations: iterations,
+        baseline: baseline
+      }
+    end
+
+    let(:iterations) { 1 }
+    let(:baseline)   { false }
+
+    def result
+      Rational(board.response.numerator, board.response.denominator)
+    end
+
+    # The results below are exact, so the firmware must match Ruby's rationals
+    # regardless of whether it chose to reduce them.
+
+    describe 'addition' do
+      let(:operation) { :add }
+      let(:lhs)       { Rational(-355, 113) }
+      let(:rhs)       { Rational(22, 7) }
+
+      it 'returns the exact sum' do
+        expect(result).to eq lhs + rhs
+      end
+    end
+
+    describe 'subtraction' do
+      let(:operation) { :subtract }
+      let(:lhs)       { Rational(1, 3) }
+      let(:rhs)       { Rational(-1, 6) }
+
+      it 'returns the exact difference' do
+        expect(result).to eq lhs - rhs
+      end
+    end
+
+    describe 'multiplication' do
+      context 'when the product fits without reduction' do
+        let(:operation) { :multiply }
+        let(:lhs)       { Rational(-1234, 4321) }
+        let(:rhs)       { Rational(987, 789) }
+
+        it 'returns the exact product' do
+          expect(result).to eq lhs * rhs
+        end
+      end
+
+      context 'when the product only fits after reduction' do
+        let(:operation) { :multiply }
+        let(:lhs)       { Rational(2_000_000_000, 3) }
+        let(:rhs)       { Rational(3, 2_000_000_001) }
+
+        it 'returns the exact product' do
+          expect(result).to eq lhs * rhs
+        end
+      end
+    end
+
+    describe 'division' do
+      let(:operation) { :divide }
+      let(:lhs)       { Rational(1_000_000_007, 998_244_353) }
+      let(:rhs)       { Rational(1_000_000_007, 1_000_000_009) }
+
+      it 'returns the exact quotient' do
+        expect(result).to eq lhs / rhs
+      end
+    end
+
+    describe 'throughput' do
+      let(:operation)  { :multiply }
+      let(:lhs)        { Rational(1_000_000_007, 998_244_353) }
+      let(:rhs)        { Rational(998_244_353, 1_000_000_009) }
+      let(:iterations) { 1000 }
+
+      # The cycle counts are reported rather than checked against a threshold,
+      # so that changes to the normalization kernel can be compared on hardware.
+      it 'reports the cycles taken by a fully normalized multiplication' do
+        cycles = board.response.cycles
+        puts "r32 multiplication: #{cycles / iterations} cycles per operation"
+        expect(cycles).to be > 0
+      end
+
+      context 'with the Euclidean GCD the binary GCD replaced' do
+        let(:baseline) { true }
+
+        it 'reports the cycles taken by the old normalization' do
+          cycles = board.response.cycles
+          puts "r32 multiplication with the Euclidean GCD: #{cycles / iterations} cycles per operation"
+          expect(result).to eq lhs * rhs
+        end
+      end
+    end
+  end
+end
@@ -0,0 +1,69 @@
+#define RTL_CORTEX_M0
+
+#include <hal/lpc1100/system.hpp>
+#include <hal/lpc1100/uart.hpp>
+#include <hal/lpc1100/frequency_scaling.hpp>
+#include <rtl/assert.hpp>
+
+#include "simple_json.hpp"
+#include "drivers/json.hpp"
+
+namespace dev = hal::lpc1100;
+namespace json = spec::json;
+
+enum class operating_point : rtl::u32 {
+  irc_12mhz = 0,
+  pll_24mhz = 1,
+  pll_48mhz = 2
+};
+
+struct test_params {
+  operating_point from;
+  operating_point to;
+  rtl::u32 iterations;
+};
+
+auto switch_to(operating_point point) {
+  switch (point) {
+    case operating_point::irc_12mhz:
+      return dev::frequency_scaling::switch_to<dev::operating_point::irc_12mhz>();
+    case operating_point::pll_24mhz:
+      return dev::frequency_scaling::switch_to<dev::operating_point::pll_24mhz>();
+    default:
+      return dev::frequency_scaling::switch_to<dev::operating_point::pll_48mhz>();
+  }
+}
+
+// the response is sent over the UART at the destination operating point, so it only arrives if the UART divisor was
+// recomputed as part of the switch; the main clock frequency is read back from the clock configuration registers
+auto run_spec(const test_params& params) {
+  auto cycles = rtl::u32{0};
+
+  for (auto i = rtl::u32{0}; i < params.iterations; ++i) {
+    switch_to(params.from);
+    cycles += switch_to(params.to).cycles;
+  }
+
+  return json::object{
+    std::pair{"main_frequency", dev::clock<dev::clock_source::main>::frequency<rtl::u32>().as<rtl::hertz>()},
+    std::pair{"reported_frequency", dev::frequency_scaling::frequencies().main},
+    std::pair{"cycles", cycles}
+  };
+}
+
+[[noreturn]] void main(const dev::reset_context& context) {
+  auto spec = spec::json_driver<dev::uart0, test_params>{9600_Hz};
+
+  if (context.event == dev::reset_event::assert) {
+    spec.fail(context.assert.message);
+  }
+
+  while (true) {
+    spec.run([&](auto&&... args) {
+      return run_spec(std::forward<decltype(args)>(args)...);
+    });
+
+    // every session starts from the reset operating point
+    switch_to(operating_point::irc_12mhz);
+  }
+}
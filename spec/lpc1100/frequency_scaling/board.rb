@@ -0,0 +1,44 @@
+# Links expected:
+#   device => program upload link to device
+#   main => serial link to device UART0
+
+module LPC1100
+  class FrequencyScaling
+    def initialize(options, links)
+      @options = options
+      @links = links
+    end
+
+    def upload(program)
+      @links[:device].upload program
+    end
+
+    def response
+      @response ||= Drivers::JSON.new(@links[:main], payload).run
+    end
+
+    private
+
+    def payload
+      Class.new BinaryStruct do
+        layout :from,       :uint,
+               :to,         :uint,
+               :iterations, :uint
+      end.new(params).bytes
+    end
+
+    def params
+      @params ||= {
+        from: OPERATING_POINTS.fetch(@options.fetch(:from)),
+        to: OPERATING_POINTS.fetch(@options.fetch(:to)),
+        iterations: @options.fetch(:iterations, 1)
+      }
+    end
+
+    OPERATING_POINTS = {
+      irc_12mhz: 0,
+      pll_24mhz: 1,
+      pll_48mhz: 2
+    }.freeze
+  end
+end
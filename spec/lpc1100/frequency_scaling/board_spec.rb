@@ -0,0 +1,40 @@
+require_relative 'board'
+
+describe LPC1100::FrequencyScaling, hardware: true do
+  subject(:board) { described_class.new params, links }
+
+  describe 'operating point switches' do
+    before { board.upload 'bin/lpc1100-frequency-scaling-firmware.bin' }
+
+    let(:params) { { from: from, to: to, iterations: 10 } }
+
+    FREQUENCIES = {
+      irc_12mhz: 12_000_000,
+      pll_24mhz: 24_000_000,
+      pll_48mhz: 48_000_000
+    }.freeze
+
+    # The response is sent at the destination operating point, so receiving it
+    # at all shows that the UART divisor followed the main clock.
+    FREQUENCIES.keys.permutation(2).each do |source, destination|
+      context "from #{source} to #{destination}" do
+        let(:from) { source }
+        let(:to)   { destination }
+
+        it 'runs the main clock at the destination frequency' do
+          expect(board.response.main_frequency).to eq FREQUENCIES.fetch(destination)
+        end
+
+        it 'reports the destination frequency to drivers' do
+          expect(board.response.reported_frequency).to eq FREQUENCIES.fetch(destination)
+        end
+
+        it 'reports the cycles taken per switch' do
+          cycles = board.response.cycles
+          puts "#{source} -> #{destination}: #{cycles / 10} cycles"
+          expect(cycles).to be > 0
+        end
+      end
+    end
+  end
+end
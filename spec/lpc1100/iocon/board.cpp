@@ -0,0 +1,103 @@
+#define RTL_CORTEX_M0
+
+#include <hal/lpc1100/system.hpp>
+#include <hal/lpc1100/uart.hpp>
+#include <hal/lpc1100/iocon.hpp>
+#include <hal/lpc1100/ticks.hpp>
+#include <rtl/assert.hpp>
+
+#include "simple_json.hpp"
+#include "drivers/json.hpp"
+
+namespace dev = hal::lpc1100;
+namespace json = spec::json;
+
+enum class operation : rtl::u32 {
+  per_pin = 0,
+  batch   = 1
+};
+
+struct test_params {
+  operation path;
+};
+
+// @brief MMIO accesses made by a path. The Cortex-M0 has no counter for bus accesses, so they follow from the code
+//        instead: a read-modify-write is two accesses, and a lease taken while the IOCON clock is gated sets and later
+//        clears its bit in SYSAHBCLKCTRL, with a read-modify-write each.
+struct mmio_accesses {
+  rtl::u32 iocon;
+  rtl::u32 sysahbclkctrl;
+};
+
+// @brief Each pin is a read-modify-write of its IOCON register under a lease of its own.
+constexpr auto per_pin_accesses(rtl::u32 pins, bool leased) {
+  return mmio_accesses{2 * pins, leased ? 0 : 4 * pins};
+}
+
+// @brief Each pin is a single IOCON store, under one lease for the whole batch.
+constexpr auto batch_accesses(rtl::u32 pins, bool leased) {
+  return mmio_accesses{pins, leased ? 0 : 4u};
+}
+
+// every pin under test becomes a pull-up input, which is harmless whatever it is connected to
+template <dev::pin pin> using pullup = dev::iocon_config<pin, 0b000, dev::iocon_pullup>;
+
+template <dev::pin... pins> auto configure_per_pin() {
+  (dev::physical_io<pins>{dev::physical_io<pins>::termination::pullup,
+                          dev::physical_io<pins>::digital_input_options::none}, ...);
+}
+
+template <dev::pin... pins> auto read_back() {
+  auto power = dev::power_lease<dev::peripheral::iocon>{};
+  auto checksum = rtl::u32{0};
+
+  ((checksum = checksum * 31 + rtl::mmio<pullup<pins>::address, rtl::u32>::read()), ...);
+
+  return checksum;
+}
+
+auto run_spec(const test_params& params) {
+  constexpr auto pins = rtl::u32{8};
+
+  auto leased = dev::power_users<dev::peripheral::iocon>() != 0;
+  auto accesses = mmio_accesses{};
+  auto start = dev::cycle_counter::now();
+
+  switch (params.path) {
+    case operation::per_pin:
+      configure_per_pin<dev::pin::PIO2_4, dev::pin::PIO2_5, dev::pin::PIO2_6, dev::pin::PIO2_7, dev::pin::PIO2_8,
+                        dev::pin::PIO2_9, dev::pin::PIO2_10, dev::pin::PIO3_4>();
+      accesses = per_pin_accesses(pins, leased);
+      break;
+    case operation::batch:
+      dev::configure_pins<pullup<dev::pin::PIO2_4>, pullup<dev::pin::PIO2_5>, pullup<dev::pin::PIO2_6>,
+                          pullup<dev::pin::PIO2_7>, pullup<dev::pin::PIO2_8>, pullup<dev::pin::PIO2_9>,
+                          pullup<dev::pin::PIO2_10>, pullup<dev::pin::PIO3_4>>();
+      accesses = batch_accesses(pins, leased);
+      break;
+  }
+
+  auto cycles = dev::cycle_counter::since(start);
+
+  return json::object{
+    std::pair{"cycles", cycles},
+    std::pair{"iocon_accesses", accesses.iocon},
+    std::pair{"sysahbclkctrl_accesses", accesses.sysahbclkctrl},
+    std::pair{"checksum", read_back<dev::pin::PIO2_4, dev::pin::PIO2_5, dev::pin::PIO2_6, dev::pin::PIO2_7,
+                                    dev::pin::PIO2_8, dev::pin::PIO2_9, dev::pin::PIO2_10, dev::pin::PIO3_4>()}
+  };
+}
+
+[[noreturn]] void main(const dev::reset_context& context) {
+  auto spec = spec::json_driver<dev::uart0, test_params>{9600_Hz};
+
+  if (context.event == dev::reset_event::assert) {
+    spec.fail(context.assert.message);
+  }
+
+  while (true) {
+    spec.run([&](auto&&... args) {
+      return run_spec(std::forward<decltype(args)>(args)...);
+    });
+  }
+}
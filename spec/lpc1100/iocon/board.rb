@@ -0,0 +1,39 @@
+# Links expected:
+#   device => program upload link to device
+#   main => serial link to device UART0
+
+module LPC1100
+  class IOCON
+    def initialize(options, links)
+      @options = options
+      @links = links
+    end
+
+    def upload(program)
+      @links[:device].upload program
+    end
+
+    def response
+      @response ||= Drivers::JSON.new(@links[:main], payload).run
+    end
+
+    private
+
+    def payload
+      Class.new BinaryStruct do
+        layout :path, :uint
+      end.new(params).bytes
+    end
+
+    def params
+      @params ||= {
+        path: PATHS.fetch(@options.fetch(:path))
+      }
+    end
+
+    PATHS = {
+      per_pin: 0,
+      batch:   1
+    }.freeze
+  end
+end
@@ -0,0 +1,33 @@
+require_relative 'board'
+
+describe LPC1100::IOCON, hardware: true do
+  subject(:board) { described_class.new params, links }
+
+  describe 'pin configuration' do
+    before { board.upload 'bin/lpc1100-iocon-firmware.bin' }
+
+    let(:per_pin) { described_class.new({ path: :per_pin }, links).response }
+    let(:batch)   { described_class.new({ path: :batch }, links).response }
+
+    it 'leaves the same IOCON registers with either path' do
+      expect(batch.checksum).to eq per_pin.checksum
+    end
+
+    # The cycle and MMIO access counts are reported so that the two paths can
+    # be compared on hardware; the batch leases the IOCON clock once, which
+    # is 4 SYSAHBCLKCTRL accesses for all pins instead of 4 per pin.
+    it 'configures the pins faster in a batch' do
+      [['per-pin', per_pin], ['batch', batch]].each do |name, path|
+        puts "#{name}: #{path.cycles} cycles, #{path.iocon_accesses} IOCON and " \
+             "#{path.sysahbclkctrl_accesses} SYSAHBCLKCTRL accesses"
+      end
+
+      expect(batch.cycles).to be < per_pin.cycles
+    end
+
+    it 'accesses the IOCON and SYSAHBCLKCTRL registers less in a batch' do
+      expect(batch.iocon_accesses).to be < per_pin.iocon_accesses
+      expect(batch.sysahbclkctrl_accesses).to be <= per_pin.sysahbclkctrl_accesses
+    end
+  end
+end
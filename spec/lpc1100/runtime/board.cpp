@@ -0,0 +1,83 @@
+#define RTL_CORTEX_M0
+
+#include <hal/lpc1100/system.hpp>
+#include <hal/lpc1100/uart.hpp>
+#include <hal/lpc1100/ticks.hpp>
+#include <rtl/assert.hpp>
+
+#include "simple_json.hpp"
+#include "drivers/json.hpp"
+
+namespace dev = hal::lpc1100;
+namespace json = spec::json;
+
+// The same board is linked against the RTL arithmetic runtime and against libgcc, so the operations below are plain C++
+// operators which the compiler lowers to the run-time ABI routines under test.
+enum class runtime_operation : rtl::u32 {
+  divide_u32    = 0,
+  divide_i32    = 1,
+  divide_u64    = 2,
+  divide_i64    = 3,
+  multiply_u64  = 4
+};
+
+struct test_params {
+  runtime_operation operation;
+  rtl::i64 lhs;
+  rtl::i64 rhs;
+  rtl::u32 iterations;
+};
+
+// the operands are laundered through volatile variables so that the work cannot be hoisted out of the loop
+template <typename T, typename F> auto benchmark(const test_params& params, F kernel) {
+  volatile auto lhs = static_cast<T>(params.lhs);
+  volatile auto rhs = static_cast<T>(params.rhs);
+
+  auto result = std::pair<T, T>{};
+  auto start = dev::cycle_counter::now();
+
+  for (auto i = rtl::u32{0}; i < params.iterations; ++i) {
+    result = kernel(lhs, rhs);
+  }
+
+  auto cycles = dev::cycle_counter::since(start);
+
+  return json::object{
+    std::pair{"result", static_cast<rtl::i64>(result.first)},
+    std::pair{"remainder", static_cast<rtl::i64>(result.second)},
+    std::pair{"cycles", cycles}
+  };
+}
+
+auto run_spec(const test_params& params) {
+  dev::cycle_counter::enable();
+
+  auto divide = [](auto lhs, auto rhs) { return std::pair{lhs / rhs, lhs % rhs}; };
+
+  switch (params.operation) {
+    case runtime_operation::divide_u32:
+      return benchmark<rtl::u32>(params, divide);
+    case runtime_operation::divide_i32:
+      return benchmark<rtl::i32>(params, divide);
+    case runtime_operation::divide_u64:
+      return benchmark<rtl::u64>(params, divide);
+    case runtime_operation::divide_i64:
+      return benchmark<rtl::i64>(params, divide);
+    default:
+      return benchmark<rtl::u64>(params, [](auto lhs, auto rhs) { return std::pair{lhs * rhs, decltype(lhs){0}}; });
+  }
+}
+
+[[noreturn]] void main(const dev::reset_context& context) {
+  auto spec = spec::json_driver<dev::uart0, test_params>{9600_Hz};
+
+  if (context.event == dev::reset_event::assert) {
+    spec.fail(context.assert.message);
+  }
+
+  while (true) {
+    spec.run([&](auto&&... args) {
+      return run_spec(std::forward<decltype(args)>(args)...);
+    });
+  }
+}
@@ -0,0 +1,48 @@
+# Links expected:
+#   device => program upload link to device
+#   main => serial link to device UART0
+
+module LPC1100
+  class Runtime
+    def initialize(options, links)
+      @options = options
+      @links = links
+    end
+
+    def upload(program)
+      @links[:device].upload program
+    end
+
+    def response
+      @response ||= Drivers::JSON.new(@links[:main], payload).run
+    end
+
+    private
+
+    def payload
+      Class.new BinaryStruct do
+        layout :operation,  :uint,
+               :lhs,        :int64,
+               :rhs,        :int64,
+               :iterations, :uint
+      end.new(params).bytes
+    end
+
+    def params
+      @params ||= {
+        operation: OPERATIONS.fetch(@options.fetch(:operation)),
+        lhs: @options.fetch(:lhs),
+        rhs: @options.fetch(:rhs),
+        iterations: @options.fetch(:iterations, 1)
+      }
+    end
+
+    OPERATIONS = {
+      divide_u32:   0,
+      divide_i32:   1,
+      divide_u64:   2,
+      divide_i64:   3,
+      multiply_u64: 4
+    }.freeze
+  end
+end
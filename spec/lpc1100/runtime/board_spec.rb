@@ -0,0 +1,77 @@
+require_relative 'board'
+
+describe LPC1100::Runtime, hardware: true do
+  subject(:board) { described_class.new params, links }
+
+  let(:params) do
+    {
+      operation: operation,
+      lhs: lhs,
+      rhs: rhs,
+      iterations: iterations
+    }
+  end
+
+  let(:iterations) { 100 }
+
+  # C rounds quotients towards zero, unlike Ruby's integer division.
+  def truncated_divmod(lhs, rhs)
+    remainder = lhs.remainder(rhs)
+    [(lhs - remainder) / rhs, remainder]
+  end
+
+  {
+    'rtl' => 'bin/lpc1100-runtime-firmware.bin',
+    'libgcc' => 'bin/lpc1100-runtime-libgcc-firmware.bin'
+  }.each do |runtime, firmware|
+    describe "the #{runtime} arithmetic runtime" do
+      before { board.upload firmware }
+
+      let(:runtime) { runtime }
+
+      # The cycle counts are reported rather than checked against a threshold,
+      # so that both runtimes can be compared on the same hardware.
+      def report(description)
+        cycles = board.response.cycles
+        puts "#{runtime} #{description}: #{cycles / iterations} cycles per operation"
+      end
+
+      [
+        [:divide_u32, 4_000_000_000, 7],
+        [:divide_u32, 123_456_789, 65_536],
+        [:divide_i32, -2_000_000_000, 12_345],
+        [:divide_i32, 1_000_000_007, -3],
+        [:divide_u64, 0x7FFF_FFFF_FFFF_FFFF, 1_000],
+        [:divide_u64, 0x7FFF_FFFF_FFFF_FFFF, 3_000_000_019],
+        [:divide_u64, 0x7FFF_FFFF_FFFF_FFFF, 0x1_2345_6789],
+        [:divide_u64, 0x1234_5678, 1_000],
+        [:divide_i64, -0x7FFF_FFFF_FFFF_FFFF, 1_000_000_007],
+        [:divide_i64, 0x1234_5678_9ABC_DEF0, -0x1_0000_0001]
+      ].each do |op, dividend, divisor|
+        context "when dividing #{dividend} by #{divisor} (#{op})" do
+          let(:operation) { op }
+          let(:lhs)       { dividend }
+          let(:rhs)       { divisor }
+
+          it 'returns the truncated quotient and remainder' do
+            quotient, remainder = truncated_divmod(lhs, rhs)
+            expect(board.response.result).to eq quotient
+            expect(board.response.remainder).to eq remainder
+            report "#{op} #{lhs} / #{rhs}"
+          end
+        end
+      end
+
+      context 'when multiplying 64-bit integers' do
+        let(:operation) { :multiply_u64 }
+        let(:lhs)       { 0x1234_5678_9 }
+        let(:rhs)       { 0x7654_321 }
+
+        it 'returns the product' do
+          expect(board.response.result).to eq lhs * rhs
+          report 'multiply_u64'
+        end
+      end
+    end
+  end
+end
@@ -0,0 +1,102 @@
+#define RTL_CORTEX_M0
+
+#include <hal/lpc1100/system.hpp>
+#include <hal/lpc1100/uart.hpp>
+#include <rtl/assert.hpp>
+#include <sys/scan.hpp>
+
+#include "simple_json.hpp"
+#include "drivers/json.hpp"
+
+namespace dev = hal::lpc1100;
+namespace json = spec::json;
+
+enum class field_kind : rtl::u32 {
+  decimal  = 0,
+  hex      = 1,
+  fixed    = 2,
+  token    = 3,
+  command  = 4
+};
+
+struct test_params {
+  field_kind field;
+  char input[32];
+};
+
+namespace spec::json
+{
+
+template <> struct json_type_for<rtl::waitable::status> { using type = string; };
+template <> string to_json_type(rtl::waitable::status element) {
+  switch (element) {
+    case rtl::waitable::status::complete:
+      return "complete";
+    case rtl::waitable::status::failed:
+      return "failed";
+    default:
+      return "pending";
+  }
+}
+
+}
+
+// feeds the input one byte at a time, exactly as the UART receive interrupt would
+template <typename T> auto feed(T fiber, const char* input, std::size_t length) {
+  for (auto i = std::size_t{0}; i < length && input[i] != '\0'; ++i) {
+    auto status = fiber(static_cast<rtl::u8>(input[i]));
+
+    if (status != rtl::waitable::status::pending) {
+      return status;
+    }
+  }
+
+  return rtl::waitable::status::pending;
+}
+
+auto run_spec(const test_params& params) {
+  auto value = rtl::i32{0};
+  auto unsigned_value = rtl::u32{0};
+  char token[8] = {};
+  auto status = rtl::waitable::status::pending;
+
+  switch (params.field) {
+    case field_kind::decimal:
+      status = feed(sys::scan(std::pair{" \n", &value}), params.input, sizeof(params.input));
+      break;
+    case field_kind::hex:
+      status = feed(sys::scan(std::pair{" \n", sys::hex(&unsigned_value)}), params.input, sizeof(params.input));
+      value = static_cast<rtl::i32>(unsigned_value);
+      break;
+    case field_kind::fixed:
+      status = feed(sys::scan(std::pair{" \n", sys::fixed<3>(&value)}), params.input, sizeof(params.input));
+      break;
+    case field_kind::token:
+      status = feed(sys::scan(std::pair{" \n", sys::token(token)}), params.input, sizeof(params.input));
+      break;
+    case field_kind::command:
+      status = feed(sys::scan(std::pair{" ", sys::token(token)}, std::pair{"\n", &value}),
+                    params.input, sizeof(params.input));
+      break;
+  }
+
+  return json::object{
+    std::pair{"status", status},
+    std::pair{"value", value},
+    std::pair{"token", static_cast<const char*>(token)}
+  };
+}
+
+[[noreturn]] void main(const dev::reset_context& context) {
+  auto spec = spec::json_driver<dev::uart0, test_params>{9600_Hz};
+
+  if (context.event == dev::reset_event::assert) {
+    spec.fail(context.assert.message);
+  }
+
+  while (true) {
+    spec.run([&](auto&&... args) {
+      return run_spec(std::forward<decltype(args)>(args)...);
+    });
+  }
+}
@@ -0,0 +1,48 @@
+# Links expected:
+#   device => program upload link to device
+#   main => serial link to device UART0
+
+module LPC1100
+  class Scan
+    def initialize(options, links)
+      @options = options
+      @links = links
+    end
+
+    def upload(program)
+      @links[:device].upload program
+    end
+
+    def response
+      @response ||= Drivers::JSON.new(@links[:main], payload).run
+    end
+
+    private
+
+    def payload
+      header.bytes + input.ljust(INPUT_LENGTH, "\0").bytes
+    end
+
+    def header
+      Class.new BinaryStruct do
+        layout :field, :uint
+      end.new(field: FIELDS.fetch(@options.fetch(:field)))
+    end
+
+    def input
+      @options.fetch(:input).tap do |input|
+        raise 'input too long' if input.length > INPUT_LENGTH
+      end
+    end
+
+    INPUT_LENGTH = 32
+
+    FIELDS = {
+      decimal: 0,
+      hex:     1,
+      fixed:   2,
+      token:   3,
+      command: 4
+    }.freeze
+  end
+end
@@ -0,0 +1,152 @@
+require_relative 'board'
+
+describe LPC1100::Scan, hardware: true do
+  subject(:board) { described_class.new params, links }
+
+  describe 'sys::scan' do
+    before { board.upload 'bin/lpc1100-scan-firmware.bin' }
+
+    let(:params) { { field: field, input: input } }
+
+    describe 'decimal field' do
+      let(:field) { :decimal }
+
+      context 'with a negative number' do
+        let(:input) { "-1234\n" }
+
+        it 'completes on the terminator' do
+          expect(board.response.status).to eq 'complete'
+        end
+
+        it 'parses the value' do
+          expect(board.response.value).to eq(-1234)
+        end
+      end
+
+      context 'with the smallest representable number' do
+        let(:input) { "-2147483648\n" }
+
+        it 'parses the value' do
+          expect(board.response.value).to eq(-2_147_483_648)
+        end
+      end
+
+      context 'with an out of range number' do
+        let(:input) { "2147483648\n" }
+
+        it 'fails' do
+          expect(board.response.status).to eq 'failed'
+        end
+      end
+
+      context 'with a malformed number' do
+        let(:input) { "12a4\n" }
+
+        it 'fails' do
+          expect(board.response.status).to eq 'failed'
+        end
+      end
+
+      context 'without a terminator' do
+        let(:input) { '1234' }
+
+        it 'is still pending' do
+          expect(board.response.status).to eq 'pending'
+        end
+      end
+    end
+
+    describe 'hexadecimal field' do
+      let(:field) { :hex }
+
+      context 'with a prefix' do
+        let(:input) { "0x7fA\n" }
+
+        it 'parses the value' do
+          expect(board.response.value).to eq 0x7fa
+        end
+      end
+
+      context 'without a prefix' do
+        let(:input) { "1F\n" }
+
+        it 'parses the value' do
+          expect(board.response.value).to eq 0x1f
+        end
+      end
+
+      context 'with too many digits' do
+        let(:input) { "100000000\n" }
+
+        it 'fails' do
+          expect(board.response.status).to eq 'failed'
+        end
+      end
+    end
+
+    describe 'fixed-point field' do
+      let(:field) { :fixed }
+
+      context 'with excess fractional digits' do
+        let(:input) { "3.14159\n" }
+
+        it 'truncates the value' do
+          expect(board.response.value).to eq 3141
+        end
+      end
+
+      context 'with missing fractional digits' do
+        let(:input) { "-2.5\n" }
+
+        it 'scales the value' do
+          expect(board.response.value).to eq(-2500)
+        end
+      end
+
+      context 'with an integer' do
+        let(:input) { "7\n" }
+
+        it 'scales the value' do
+          expect(board.response.value).to eq 7000
+        end
+      end
+    end
+
+    describe 'token field' do
+      let(:field) { :token }
+
+      context 'with a short token' do
+        let(:input) { 'hello world' }
+
+        it 'stops at the terminator' do
+          expect(board.response.token).to eq 'hello'
+        end
+      end
+
+      context 'with a token larger than the buffer' do
+        let(:input) { 'overlong ' }
+
+        it 'fails' do
+          expect(board.response.status).to eq 'failed'
+        end
+      end
+    end
+
+    describe 'command' do
+      let(:field) { :command }
+      let(:input) { "SET -42\n" }
+
+      it 'completes on the last terminator' do
+        expect(board.response.status).to eq 'complete'
+      end
+
+      it 'parses the token' do
+        expect(board.response.token).to eq 'SET'
+      end
+
+      it 'parses the argument' do
+        expect(board.response.value).to eq(-42)
+      end
+    end
+  end
+end
@@ -0,0 +1,149 @@
+#define RTL_CORTEX_M0
+
+#include <hal/lpc1100/system.hpp>
+#include <hal/lpc1100/uart.hpp>
+#include <hal/lpc1100/ticks.hpp>
+#include <rtl/assert.hpp>
+
+#include "simple_json.hpp"
+#include "drivers/json.hpp"
+
+namespace dev = hal::lpc1100;
+namespace json = spec::json;
+
+enum class stdlib_operation : rtl::u32 {
+  memcpy    = 0,
+  memmove   = 1,
+  memset    = 2,
+  memcmp    = 3,
+  strlen    = 4
+};
+
+struct test_params {
+  stdlib_operation operation;
+  rtl::u32 destination_offset;
+  rtl::u32 source_offset;
+  rtl::u32 length;
+  rtl::u32 iterations;
+};
+
+constexpr auto buffer_size = std::size_t{512};
+
+alignas(8) rtl::u8 buffer[buffer_size];
+alignas(8) rtl::u8 source[buffer_size];
+alignas(8) rtl::u8 expected[buffer_size];
+
+// the reference results are computed a byte at a time through volatile pointers, so that the compiler cannot lower
+// them to the routines under test
+auto reference_move(volatile rtl::u8* dest, const volatile rtl::u8* src, std::size_t n) {
+  if (dest <= src) {
+    for (auto i = std::size_t{0}; i < n; ++i) {
+      dest[i] = src[i];
+    }
+  } else {
+    for (auto i = n; i != 0; --i) {
+      dest[i - 1] = src[i - 1];
+    }
+  }
+}
+
+auto reference_fill(volatile rtl::u8* dest, rtl::u8 value, std::size_t n) {
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    dest[i] = value;
+  }
+}
+
+auto reset_buffers() {
+  for (auto i = std::size_t{0}; i < buffer_size; ++i) {
+    static_cast<volatile rtl::u8*>(buffer)[i] = static_cast<rtl::u8>(i * 13 + 1);
+    static_cast<volatile rtl::u8*>(expected)[i] = static_cast<rtl::u8>(i * 13 + 1);
+    static_cast<volatile rtl::u8*>(source)[i] = static_cast<rtl::u8>(i * 7 + 3);
+  }
+}
+
+auto buffers_match() {
+  for (auto i = std::size_t{0}; i < buffer_size; ++i) {
+    if (static_cast<volatile rtl::u8*>(buffer)[i] != static_cast<volatile rtl::u8*>(expected)[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// the operation is repeated on the same buffers, which is idempotent for everything but overlapping moves, so the
+// result is checked after the first iteration only
+template <typename F, typename G> auto benchmark(const test_params& params, F operation, G check) {
+  auto correct = check(operation());
+
+  auto start = dev::cycle_counter::now();
+
+  for (auto i = rtl::u32{1}; i < params.iterations; ++i) {
+    operation();
+  }
+
+  return json::object{
+    std::pair{"correct", correct},
+    std::pair{"cycles", dev::cycle_counter::since(start)}
+  };
+}
+
+auto run_spec(const test_params& params) {
+  rtl::assert(params.destination_offset + params.length <= buffer_size, TRACE("destination out of bounds"));
+  rtl::assert(params.source_offset + params.length < buffer_size, TRACE("source out of bounds"));
+
+  dev::cycle_counter::enable();
+  reset_buffers();
+
+  volatile auto length = params.length;
+  auto dest = buffer + params.destination_offset;
+  auto src = source + params.source_offset;
+
+  switch (params.operation) {
+    case stdlib_operation::memcpy:
+      return benchmark(params, [&]() { return memcpy(dest, src, length); }, [&](auto) {
+        reference_move(expected + params.destination_offset, src, params.length);
+        return buffers_match();
+      });
+    case stdlib_operation::memmove:
+      // moves within the destination buffer itself, so the regions overlap
+      return benchmark(params, [&]() { return memmove(dest, buffer + params.source_offset, length); }, [&](auto) {
+        reference_move(expected + params.destination_offset, expected + params.source_offset, params.length);
+        return buffers_match();
+      });
+    case stdlib_operation::memset:
+      return benchmark(params, [&]() { return memset(dest, 0xA5, length); }, [&](auto) {
+        reference_fill(expected + params.destination_offset, 0xA5, params.length);
+        return buffers_match();
+      });
+    case stdlib_operation::memcmp:
+      // the buffers only differ in their last byte, so the whole range is compared
+      reference_move(dest, src, params.length);
+      static_cast<volatile rtl::u8*>(dest)[params.length - 1] ^= 0x80;
+
+      return benchmark(params, [&]() { return memcmp(dest, src, length); }, [&](auto result) {
+        return (src[params.length - 1] & 0x80) ? (result < 0) : (result > 0);
+      });
+    default:
+      reference_fill(src, 'a', params.length);
+      static_cast<volatile rtl::u8*>(src)[params.length] = '\0';
+
+      return benchmark(params, [&]() { return strlen(reinterpret_cast<const char*>(src)); }, [&](auto result) {
+        return result == params.length;
+      });
+  }
+}
+
+[[noreturn]] void main(const dev::reset_context& context) {
+  auto spec = spec::json_driver<dev::uart0, test_params>{9600_Hz};
+
+  if (context.event == dev::reset_event::assert) {
+    spec.fail(context.assert.message);
+  }
+
+  while (true) {
+    spec.run([&](auto&&... args) {
+      return run_spec(std::forward<decltype(args)>(args)...);
+    });
+  }
+}
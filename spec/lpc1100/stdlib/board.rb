@@ -0,0 +1,50 @@
+# Links expected:
+#   device => program upload link to device
+#   main => serial link to device UART0
+
+module LPC1100
+  class Stdlib
+    def initialize(options, links)
+      @options = options
+      @links = links
+    end
+
+    def upload(program)
+      @links[:device].upload program
+    end
+
+    def response
+      @response ||= Drivers::JSON.new(@links[:main], payload).run
+    end
+
+    private
+
+    def payload
+      Class.new BinaryStruct do
+        layout :operation,          :uint,
+               :destination_offset, :uint,
+               :source_offset,      :uint,
+               :length,             :uint,
+               :iterations,         :uint
+      end.new(params).bytes
+    end
+
+    def params
+      @params ||= {
+        operation: OPERATIONS.fetch(@options.fetch(:operation)),
+        destination_offset: @options.fetch(:destination_offset, 0),
+        source_offset: @options.fetch(:source_offset, 0),
+        length: @options.fetch(:length),
+        iterations: @options.fetch(:iterations, 1)
+      }
+    end
+
+    OPERATIONS = {
+      memcpy:   0,
+      memmove:  1,
+      memset:   2,
+      memcmp:   3,
+      strlen:   4
+    }.freeze
+  end
+end
@@ -0,0 +1,80 @@
+require_relative 'board'
+
+describe LPC1100::Stdlib, hardware: true do
+  subject(:board) { described_class.new params, links }
+
+  describe 'memory routines' do
+    before { board.upload 'bin/lpc1100-stdlib-firmware.bin' }
+
+    let(:params) do
+      {
+        operation: operation,
+        destination_offset: destination_offset,
+        source_offset: source_offset,
+        length: length,
+        iterations: iterations
+      }
+    end
+
+    let(:iterations) { 10 }
+
+    # Every combination of relative alignment is covered, with lengths around
+    # the word and block boundaries of the implementations.
+    [0, 1, 2, 3].product([0, 1, 2, 3], [1, 7, 8, 15, 16, 33, 255]).each do |dest, src, n|
+      context "with offsets #{dest}, #{src} and length #{n}" do
+        let(:destination_offset) { dest }
+        let(:source_offset)      { src }
+        let(:length)             { n }
+
+        %i[memcpy memset memcmp strlen].each do |op|
+          describe op.to_s do
+            let(:operation) { op }
+
+            it 'matches the reference result' do
+              expect(board.response.correct).to be true
+            end
+          end
+        end
+
+        describe 'memmove to a higher address' do
+          let(:operation)          { :memmove }
+          let(:destination_offset) { dest + (n / 2) }
+
+          it 'matches the reference result with overlapping regions' do
+            expect(board.response.correct).to be true
+          end
+        end
+
+        describe 'memmove to a lower address' do
+          let(:operation)     { :memmove }
+          let(:source_offset) { src + (n / 2) }
+
+          it 'matches the reference result with overlapping regions' do
+            expect(board.response.correct).to be true
+          end
+        end
+      end
+    end
+
+    describe 'throughput' do
+      let(:destination_offset) { 0 }
+      let(:source_offset)      { 0 }
+      let(:length)             { 256 }
+      let(:iterations)         { 100 }
+
+      # The cycle counts are reported rather than checked against a threshold,
+      # so that changes to the routines can be compared on hardware.
+      %i[memcpy memmove memset memcmp strlen].each do |op|
+        context "with #{op}" do
+          let(:operation) { op }
+
+          it 'reports the cycles taken per call' do
+            cycles = board.response.cycles
+            puts "#{op} (#{length} bytes): #{cycles / (iterations - 1)} cycles"
+            expect(cycles).to be > 0
+          end
+        end
+      end
+    end
+  end
+end
@@ -30,7 +30,7 @@ private:
   template <typename T2> auto write_json(const T2& json) {
     rtl::assert(json.size() < buffer_size, TRACE("insufficient space to buffer JSON response"));
     char buffer[buffer_size];
-    json.dump(buffer);
+    json.dump(buffer, buffer_size);
     write_str(buffer);
   }
 
@@ -0,0 +1,106 @@
+#pragma once
+
+// The rational operators as they were before the binary GCD and the expression templates, which normalized after
+// every operator with a Euclidean GCD. Specs use them as an oracle for the current operators, and as the baseline
+// the normalization kernel is benchmarked against.
+
+#include <rtl/base.hpp>
+#include <rtl/math/rational.hpp>
+
+namespace spec
+{
+
+template <typename Rational, rtl::rational_mode mode> struct euclid_rational {
+  using S = typename Rational::S;
+  using U = decltype(Rational{}.denominator());
+  using SD = typename Rational::SD;
+  using UD = std::make_unsigned_t<SD>;
+
+  // @brief Applies a single operator, one of '+', '-', '*' and '/'; divisors must be positive.
+  static constexpr auto apply(char op, Rational lhs, Rational rhs) {
+    auto lp = static_cast<SD>(lhs.numerator());
+    auto rp = static_cast<SD>(rhs.numerator());
+    auto lq = static_cast<UD>(lhs.denominator());
+    auto rq = static_cast<UD>(rhs.denominator());
+
+    auto pd = SD{0};
+    auto qd = UD{0};
+
+    switch (op) {
+      case '+':
+        pd = lp * static_cast<SD>(rq) + static_cast<SD>(lq) * rp;
+        qd = lq * rq;
+        break;
+      case '-':
+        pd = lp * static_cast<SD>(rq) - static_cast<SD>(lq) * rp;
+        qd = lq * rq;
+        break;
+      case '*':
+        pd = lp * rp;
+        qd = lq * rq;
+        break;
+      default:
+        pd = lp * static_cast<SD>(rq);
+        qd = lq * static_cast<UD>(rp);
+        break;
+    }
+
+    normalize(pd, qd);
+    return Rational{static_cast<S>(pd), static_cast<U>(qd)};
+  }
+
+  static constexpr auto gcd(UD a, UD b) {
+    auto gcd = UD{1};
+
+    while (b != 0) {
+      gcd = b;
+      b = a % b;
+      a = gcd;
+    }
+
+    return gcd;
+  }
+
+  static constexpr auto normalize(SD& pd, UD& qd) {
+    if (pd == 0) {
+      qd = 1;
+      return;
+    }
+
+    auto positive = true;
+
+    if (pd < 0) {
+      positive = false;
+      pd *= -1;
+    }
+
+    if (mode == rtl::rational_mode::best) {
+      while ((pd % 2 == 0) && (qd % 2 == 0)) {
+        pd /= 2;
+        qd /= 2;
+      }
+
+      auto inv = rtl::detail::modinv<UD>(gcd(static_cast<UD>(pd), qd));
+
+      if (inv > 1) {
+        pd = static_cast<SD>(static_cast<UD>(pd) * inv);
+        qd *= inv;
+      }
+    }
+
+    while (pd > std::numeric_limits<S>::max() || qd > std::numeric_limits<U>::max()) {
+      pd /= 2;
+      qd /= 2;
+    }
+
+    if (!positive) {
+      pd *= -1;
+    }
+
+    if (qd == 0) {
+      qd = 1;
+    }
+  }
+};
+
+}
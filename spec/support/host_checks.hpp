@@ -0,0 +1,33 @@
+#pragma once
+
+// Checks for programs built and run on the host by HostProgram. Each failed check prints its location and expression,
+// and the program exits with a nonzero status if any check failed.
+
+#include <cstdio>
+
+#include <rtl/base.hpp>
+#include <rtl/nvram.hpp>
+
+namespace rtl::nv {
+nvram const char* assert_message = nullptr;
+}
+
+namespace spec::host
+{
+
+inline auto failures = 0;
+
+inline auto check(bool passed, const char* expression, const char* file, int line) {
+  if (!passed) {
+    std::printf("%s:%d: check failed: %s\n", file, line, expression);
+    ++failures;
+  }
+}
+
+inline auto report() {
+  return (failures == 0) ? 0 : 1;
+}
+
+}
+
+#define CHECK(...) spec::host::check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
@@ -0,0 +1,47 @@
+require 'open3'
+require 'tmpdir'
+
+# Builds a C++ program with the host compiler and runs it. Host programs check
+# the platform-independent parts of the RTL without a device, and print every
+# failed check; they are built with the undefined behavior sanitizer, so that
+# any overflow in the code under test also fails them.
+class HostProgram
+  Result = Struct.new(:output, :success?)
+
+  FLAGS = %w[
+    -std=c++17 -O2 -Wall -Wextra -fno-builtin
+    -fsanitize=undefined -fno-sanitize-recover=all
+    -DRTL_CORTEX_M0 -Isrc -Ispec/support
+  ].freeze
+
+  def initialize(*sources)
+    @sources = sources
+  end
+
+  def run
+    Dir.mktmpdir do |dir|
+      binary = File.join(dir, 'program')
+      build binary
+      output, status = Open3.capture2e(binary)
+      Result.new(output, status.success?)
+    end
+  end
+
+  # Only compiles the program, with the given macros defined, for checks
+  # which must fail compilation.
+  def compile(*macros)
+    output, status = Open3.capture2e(compiler, *FLAGS, '-fsyntax-only', *macros.map { |macro| "-D#{macro}" }, *@sources)
+    Result.new(output, status.success?)
+  end
+
+  private
+
+  def compiler
+    ENV.fetch('CXX', 'g++')
+  end
+
+  def build(binary)
+    output, status = Open3.capture2e(compiler, *FLAGS, *@sources, '-o', binary)
+    raise "host program failed to build:\n#{output}" unless status.success?
+  end
+end
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <rtl/base.hpp>
+#include <rtl/assert.hpp>
+#include <sys/format.hpp>
 
 namespace spec::json
 {
@@ -31,7 +33,9 @@ public:
     return detail::max(std::size_t{2}, 1 + 4 * index_sequence().size() + element_sizes(index_sequence()));
   }
 
-  char* dump(char* buffer) const {
+  // @brief Dumps into a buffer of \p size characters, which must be at least size() + 1.
+  char* dump(char* buffer, std::size_t size) const {
+    auto end = buffer + size;
     *buffer++ = '{';
 
     for_each_element([&](auto&& element){
@@ -39,7 +43,7 @@ public:
       buffer = copy_str(buffer, element.first);
       *buffer++ = '\"'; // "
       *buffer++ = ':';
-      buffer = element.second.dump(buffer);
+      buffer = element.second.dump(buffer, static_cast<std::size_t>(end - buffer));
       *buffer++ = ',';
     }, index_sequence());
 
@@ -90,11 +94,12 @@ public:
     return detail::max(std::size_t{2}, 1 + index_sequence().size() + element_sizes(index_sequence()));
   }
 
-  char* dump(char* buffer) const {
+  char* dump(char* buffer, std::size_t size) const {
+    auto end = buffer + size;
     *buffer++ = '[';
 
     for_each_element([&](auto&& element){
-      buffer = element.dump(buffer);
+      buffer = element.dump(buffer, static_cast<std::size_t>(end - buffer));
       *buffer++ = ',';
     }, index_sequence());
 
@@ -132,7 +137,7 @@ public:
     return value ? 4 : 5;
   }
 
-  char* dump(char* buffer) const {
+  char* dump(char* buffer, std::size_t) const {
     if (value) {
       *buffer++ = 't';
       *buffer++ = 'r';
@@ -162,7 +167,7 @@ public:
     return 2 + strlen(value);
   }
 
-  char* dump(char* buffer) const {
+  char* dump(char* buffer, std::size_t) const {
     *buffer++ = '\"'; // "
 
     for (auto i = 0; value[i] != '\0'; ++i) {
@@ -183,41 +188,14 @@ class number {
 public:
   template <typename T> constexpr number(T value) : value(static_cast<rtl::i64>(value)) {}
 
-  constexpr std::size_t size() const {
-    auto size = std::size_t{0};
-    auto number = value;
-
-    if (number < 0) {
-      number = -number;
-      ++size;
-    }
-
-    do {
-      number /= 10;
-      ++size;
-    } while (number != 0);
-
-    return size;
+  std::size_t size() const {
+    return sys::format_length(std::pair{"", value});
   }
 
-  char* dump(char* buffer) const {
-    auto number = value;
-
-    auto end_pos = buffer + size();
-    auto end_pos_copy = end_pos;
-
-    if (number < 0) {
-      number = -number;
-      *buffer++ = '-';
-    }
-
-    do {
-      *--end_pos_copy = '0' + (number % 10);
-      number /= 10;
-    } while (number != 0);
-
-    *end_pos = '\0';
-    return end_pos;
+  char* dump(char* buffer, std::size_t size) const {
+    auto result = sys::format_to(buffer, size, std::pair{"", value});
+    rtl::assert(!result.truncated, TRACE("insufficient space to dump JSON number"));
+    return buffer + result.length;
   }
 
 private:
@@ -0,0 +1,198 @@
+#pragma once
+
+/// @file
+///
+/// @brief Whole-board pin maps for the LPC1100 series microcontrollers.
+///
+/// A \c board lists the function of every pin the application uses, in one place:
+///
+/// \code
+/// using pins = dev::board<dev::pin_function<dev::pin::TXD, dev::peripheral_function::uart_tx>,
+///                         dev::pin_function<dev::pin::RXD, dev::peripheral_function::uart_rx>,
+///                         dev::gpio_output<dev::pin::PIO1_5, hal::logic_level::low>,
+///                         dev::gpio_input<dev::pin::PIO0_7, dev::iocon_pullup>>;
+///
+/// auto board = pins{};
+/// board.output<dev::pin::PIO1_5>().drive_high();
+///
+/// auto uart = dev::uart0(board, 9600_Hz);
+/// \endcode
+///
+/// Assigning the same physical pin twice, possibly under two of its aliases, or to a function the pin does not
+/// provide, fails compilation. Constructing the board programs the GPIO levels and directions with one store per port
+/// and then walks a constant table of IOCON values in a single loop, so that the pins are set up in a few cycles at
+/// boot. Drivers constructed from the board take their pins from it instead of setting them up again, and fail
+/// compilation if the board does not assign their pins to them.
+///
+/// @remarks The GPIO outputs are driven to their initial level before they are switched to GPIO, so they do not glitch.
+
+#include <rtl/base.hpp>
+#include <rtl/mmio.hpp>
+#include <hal/digital_io.hpp>
+#include <hal/lpc1100/iocon.hpp>
+#include <hal/lpc1100/pin_interrupt.hpp>
+#include <hal/lpc1100/power.hpp>
+
+namespace hal::lpc1100 {
+
+namespace detail {
+
+enum class pin_direction {
+  unchanged,
+  input,
+  output
+};
+
+// @brief One row of the IOCON table of a board, as the register offset and its value.
+struct pin_entry {
+  rtl::u16 offset;
+  rtl::u16 value;
+};
+
+}
+
+/// @brief Assigns a pin to one of its peripheral functions, as described by the pin database.
+template <pin pin, peripheral_function function, rtl::u32 options = 0>
+struct pin_function : iocon_config<pin, detail::function_code(pin, function), options> {
+  static_assert(detail::function_code(pin, function) != 0, "pin does not provide this peripheral function");
+
+  static constexpr auto direction = detail::pin_direction::unchanged;
+  static constexpr auto high = false;
+};
+
+/// @brief Assigns a pin to a GPIO input.
+template <pin pin, rtl::u32 options = 0> struct gpio_input : iocon_config<pin, detail::gpio_function(pin), options> {
+  static_assert(!(options & iocon_analog), "GPIO pins must be in digital mode");
+
+  static constexpr auto direction = detail::pin_direction::input;
+  static constexpr auto high = false;
+};
+
+/// @brief Assigns a pin to a GPIO output, driven to the given level at boot.
+template <pin pin, hal::logic_level initial_level, rtl::u32 options = 0>
+struct gpio_output : iocon_config<pin, detail::gpio_function(pin), options> {
+  static_assert(!(options & iocon_analog), "GPIO pins must be in digital mode");
+
+  static constexpr auto direction = detail::pin_direction::output;
+  static constexpr auto high = (initial_level == hal::logic_level::high);
+};
+
+/// @brief GPIO output assigned by a \c board, which is driven without any setup or teardown.
+template <pin pin> class board_output : public hal::digital_output<board_output<pin>> {
+public:
+  auto drive_low() {
+    DATA::clear();
+  }
+
+  auto drive_high() {
+    DATA::set();
+  }
+
+private:
+  static constexpr auto pin_number = static_cast<std::size_t>(pin);
+  static constexpr auto port_mask = rtl::u32{1} << detail::gpio_bit(pin_number);
+
+  using DATA = rtl::mmio<detail::gpio_base(detail::gpio_port(pin_number)) + 4 * port_mask, rtl::u32>;
+};
+
+/// @brief GPIO input assigned by a \c board, which is read without any setup or teardown.
+template <pin pin> class board_input : public hal::digital_input<board_input<pin>> {
+public:
+  auto state() {
+    return DATA::read() ? hal::logic_level::high : hal::logic_level::low;
+  }
+
+  [[nodiscard]] auto wait_edge(edge edge) {
+    return pin_event<detail::gpio_line<pin>>{edge};
+  }
+
+  [[nodiscard]] auto wait_level(hal::logic_level level) {
+    return pin_event<detail::gpio_line<pin>>{level};
+  }
+
+private:
+  static constexpr auto pin_number = static_cast<std::size_t>(pin);
+  static constexpr auto port_mask = rtl::u32{1} << detail::gpio_bit(pin_number);
+
+  using DATA = rtl::mmio<detail::gpio_base(detail::gpio_port(pin_number)) + 4 * port_mask, rtl::u32>;
+};
+
+/// @brief Pin map of a whole board, as a list of \c pin_function, \c gpio_input and \c gpio_output assignments.
+///
+/// @remarks The board keeps the GPIO block powered for as long as it lives.
+template <typename... Pins> class board : private rtl::noncopyable {
+  static_assert(sizeof...(Pins) != 0, "board without pins");
+  static_assert(detail::distinct_pins<Pins::pin_number...>(), "pin assigned twice on the board");
+
+public:
+  /// @brief Programs every pin of the board.
+  board() {
+    configure_port<0>();
+    configure_port<1>();
+    configure_port<2>();
+    configure_port<3>();
+
+    auto power = power_lease<peripheral::iocon>{};
+
+    for (const auto& entry : table) {
+      IOCON::write(entry.offset, entry.value);
+    }
+  }
+
+  /// @brief Returns whether the board assigns the given pin.
+  template <pin pin> static constexpr auto assigns = ((Pins::pin_number == static_cast<std::size_t>(pin)) || ...);
+
+  /// @brief Returns whether the board assigns the given pin to the given peripheral function.
+  template <pin pin, peripheral_function function> static constexpr auto assigns_function
+    = detail::function_code(pin, function) != 0 && ((Pins::pin_number == static_cast<std::size_t>(pin)
+                                                     && (Pins::value & 0b111) == detail::function_code(pin, function))
+                                                    || ...);
+
+  template <pin pin> auto output() const {
+    static_assert(direction_of<pin>() == detail::pin_direction::output, "pin is not a GPIO output on this board");
+    return board_output<pin>{};
+  }
+
+  template <pin pin> auto input() const {
+    static_assert(direction_of<pin>() == detail::pin_direction::input, "pin is not a GPIO input on this board");
+    return board_input<pin>{};
+  }
+
+private:
+  using IOCON = rtl::mmio_block<detail::iocon_base, rtl::u32>;
+
+  static constexpr detail::pin_entry table[] = {
+    {static_cast<rtl::u16>(Pins::address - detail::iocon_base), static_cast<rtl::u16>(Pins::value)}...
+  };
+
+  template <pin pin> static constexpr auto direction_of() {
+    auto direction = detail::pin_direction::unchanged;
+    ((direction = (Pins::pin_number == static_cast<std::size_t>(pin)) ? Pins::direction : direction), ...);
+    return direction;
+  }
+
+  template <typename Pin> static constexpr auto port_bit(std::size_t port) -> rtl::u32 {
+    return (detail::gpio_port(Pin::pin_number) == port) ? (rtl::u32{1} << detail::gpio_bit(Pin::pin_number)) : 0;
+  }
+
+  template <std::size_t port> static auto configure_port() {
+    constexpr auto outputs = ((Pins::direction == detail::pin_direction::output ? port_bit<Pins>(port) : 0) | ... | 0);
+    constexpr auto inputs = ((Pins::direction == detail::pin_direction::input ? port_bit<Pins>(port) : 0) | ... | 0);
+    constexpr auto levels = ((Pins::high ? port_bit<Pins>(port) : 0) | ... | 0);
+
+    using DIR = rtl::mmio<detail::gpio_base(port) + 0x8000, rtl::u32>;
+
+    if constexpr (outputs != 0) {
+      // the address bits of the data register select which pins a store affects
+      rtl::mmio<detail::gpio_base(port) + 4 * outputs, rtl::u32>::write(levels);
+    }
+
+    if constexpr ((outputs | inputs) != 0) {
+      DIR::template write<outputs | inputs>(outputs);
+    }
+  }
+
+  power_lease<peripheral::gpio> gpio_power;
+};
+
+}
@@ -8,23 +8,11 @@
 #include <rtl/mmio.hpp>
 #include <rtl/assert.hpp>
 #include <rtl/units.hpp>
+#include <hal/lpc1100/physical_io.hpp>
+#include <hal/lpc1100/ticks.hpp>
 
 namespace hal::lpc1100 {
 
-/// @brief All clock sources available in the system.
-enum class clock_source {
-  irc,            ///< Internal IRC oscillator
-  system,         ///< External system crystal oscillator
-  pll_in,         ///< On-chip phase-locked loop input
-  pll_out,        ///< On-chip phase-locked loop output
-  watchdog_osc,   ///< Watchdog oscillator
-  watchdog,       ///< Watchdog clock
-  main,           ///< Main system-wide clock
-  core,           ///< Core clock (AHB)
-  clkout,         ///< CLKOUT source clock
-  uart            ///< UART peripheral clock
-};
-
 template <clock_source source> class clock;
 
 /// @brief The internal IRC oscillator clock.
@@ -44,7 +32,145 @@ public:
   }
 };
 
-// TODO: implement system clock, and that will be enough for now
+/// @brief How the system oscillator is driven.
+enum class system_oscillator_mode {
+  crystal,  ///< A crystal or ceramic resonator across XTALIN and XTALOUT
+  bypass    ///< An external clock signal on XTALIN, bypassing the oscillator
+};
+
+namespace detail {
+
+// @brief Worst-case start-up time of the system and watchdog oscillators, from the datasheet.
+constexpr auto oscillator_startup_time = rtl::quantity<rtl::u32, rtl::microsecond>{200};
+
+// @brief Highest core clock frequency, in hertz.
+constexpr auto max_core_rate = rtl::u32{50000000};
+
+// @brief Busy-waits for an oscillator to stabilize.
+//
+// @remarks The oscillators have no ready flag, so this waits for their worst-case start-up time. An oscillator is
+//          usually started before the core clock is raised to its final rate, so the wait is counted at the highest
+//          core clock rather than at \c clock_rate<clock_source::core>; at slower clocks it is merely longer.
+inline auto oscillator_startup_delay() {
+  using fastest_core_ticks = rtl::second::scaled<std::ratio<1, max_core_rate>>;
+  delay_cycles(oscillator_startup_time.as<fastest_core_ticks>());
+}
+
+}
+
+/// @brief The external system oscillator clock.
+template <> class clock<clock_source::system> {
+private:
+  using SYSOSCCTRL = rtl::mmio<0x40048020, rtl::u32>;
+  using PDRUNCFG = rtl::mmio<0x40048238, rtl::u32>;
+
+public:
+  /// @remarks This is the frequency passed to the last call to \c enable, or zero if the oscillator was never enabled.
+  template <typename T> static auto frequency() {
+    return rtl::quantity<T, rtl::hertz>{static_cast<T>(rate)};
+  }
+
+  /// @brief Starts the system oscillator for a crystal or external clock of the given frequency in hertz.
+  ///
+  /// @remarks This returns once the oscillator has had time to stabilize, so it can drive the PLL right away.
+  template <rtl::u32 frequency, system_oscillator_mode mode = system_oscillator_mode::crystal> static auto enable() {
+    static_assert(frequency >= 1000000 && frequency <= 25000000, "system oscillator must be between 1 and 25 MHz");
+
+    constexpr auto bypass = (mode == system_oscillator_mode::bypass) ? 0b01 : 0b00;
+    constexpr auto high_range = (frequency > 20000000) ? 0b10 : 0b00;
+
+    SYSOSCCTRL::write<0b11>(bypass | high_range);
+    rate = frequency;
+
+    if (PDRUNCFG::any<0b100000>()) {
+      PDRUNCFG::clear<0b100000>(); // power-up system oscillator
+      detail::oscillator_startup_delay();
+    }
+  }
+
+  static auto disable() {
+    PDRUNCFG::set<0b100000>(); // power-down system oscillator
+  }
+
+private:
+  static inline rtl::u32 rate = 0;
+};
+
+namespace detail {
+
+// @brief Nominal analog output frequencies of the watchdog oscillator for each FREQSEL value, in hertz.
+constexpr rtl::u32 watchdog_analog_rates[16] = {
+  0,       600000,  1050000, 1400000, 1750000, 2100000, 2400000, 2700000,
+  3000000, 3250000, 3500000, 3750000, 4000000, 4200000, 4400000, 4600000
+};
+
+// @brief Solves the watchdog oscillator configuration closest to a frequency in hertz, at compile time.
+//
+// The output frequency is the analog frequency selected by FREQSEL divided by 2 * (1 + DIVSEL). Among the settings
+// closest to the requested frequency, the lowest analog frequency is used, to save power.
+template <rtl::u32 frequency> struct watchdog_oscillator_solution {
+  static_assert(frequency >= 9375 && frequency <= 2300000, "watchdog oscillator must be between 9.375 kHz and 2.3 MHz");
+
+  static constexpr auto solve() {
+    auto best = rtl::u32{0}, best_error = std::numeric_limits<rtl::u32>::max();
+
+    for (auto freqsel = rtl::u32{1}; freqsel < 16; ++freqsel) {
+      for (auto divsel = rtl::u32{0}; divsel < 32; ++divsel) {
+        auto output = watchdog_analog_rates[freqsel] / (2 * (1 + divsel));
+        auto error = (output > frequency) ? output - frequency : frequency - output;
+
+        if (error < best_error) {
+          best = divsel | (freqsel << 5);
+          best_error = error;
+        }
+      }
+    }
+
+    return best;
+  }
+
+  // WDTOSCCTRL value, with DIVSEL in bits 0-4 and FREQSEL in bits 5-8
+  static constexpr auto value = solve();
+
+  // nominal frequency of the solved configuration, in hertz; the oscillator itself is only accurate to within 40%.
+  static constexpr auto nominal = watchdog_analog_rates[value >> 5] / (2 * (1 + (value & 0b11111)));
+};
+
+}
+
+/// @brief The low-power watchdog oscillator clock.
+///
+/// @remarks The watchdog oscillator can also drive the main clock, to run at very low power between bursts of activity.
+template <> class clock<clock_source::watchdog_osc> {
+private:
+  using WDTOSCCTRL = rtl::mmio<0x40048024, rtl::u32>;
+  using PDRUNCFG = rtl::mmio<0x40048238, rtl::u32>;
+
+public:
+  /// @remarks This is the nominal frequency of the current configuration.
+  template <typename T> static auto frequency() {
+    auto divider = 2 * (1 + WDTOSCCTRL::read<0b11111>());
+    auto analog = detail::watchdog_analog_rates[WDTOSCCTRL::read<0b111100000>() >> 5];
+
+    return rtl::quantity<T, rtl::hertz>{static_cast<T>(analog / divider)};
+  }
+
+  /// @brief Starts the watchdog oscillator at the nominal frequency closest to the given frequency in hertz.
+  ///
+  /// @remarks The configuration is solved at compile time; frequencies out of range fail compilation.
+  template <rtl::u32 frequency> static auto enable() {
+    WDTOSCCTRL::write<0b111111111>(detail::watchdog_oscillator_solution<frequency>::value);
+
+    if (PDRUNCFG::any<0b1000000>()) {
+      PDRUNCFG::clear<0b1000000>(); // power-up watchdog oscillator
+      detail::oscillator_startup_delay();
+    }
+  }
+
+  static auto disable() {
+    PDRUNCFG::set<0b1000000>(); // power-down watchdog oscillator
+  }
+};
 
 template <> class clock<clock_source::pll_in> {
 private:
@@ -52,12 +178,12 @@ private:
   using SYSPLLCLKUEN = rtl::mmio<0x40048044, rtl::u32>;
 
 public:
-  template <typename T> static auto frequency() {
+  template <typename T> static auto frequency() -> rtl::quantity<T, rtl::hertz> {
     switch (SYSPLLCLKSEL::read<0b1>()) {
       case 0b0:
         return clock<clock_source::irc>::frequency<T>();
       case 0b1:
-        //return clock<clock_source::system>::frequency();
+        return clock<clock_source::system>::frequency<T>();
       default:
         rtl::unreachable(TRACE("invalid clock configuration"));
     }
@@ -78,8 +204,50 @@ public:
     SYSPLLCLKUEN::write<0b1>(0b0);
     SYSPLLCLKUEN::write<0b1>(0b1);
   }
+
+  static auto source() {
+    return (SYSPLLCLKSEL::read<0b1>() == 0b0) ? clock_source::irc : clock_source::system;
+  }
 };
 
+namespace detail {
+
+// @brief Returns log2 of the smallest PLL post divider P keeping the oscillator in range, or 4 if there is none.
+constexpr auto pll_post_divider(rtl::u32 output) {
+  for (auto psel = rtl::u32{0}; psel < 4; ++psel) {
+    auto fcco = rtl::u64{2} * (rtl::u64{1} << psel) * output;
+
+    if (fcco >= 156000000 && fcco <= 320000000) {
+      return psel;
+    }
+  }
+
+  return rtl::u32{4};
+}
+
+// @brief Solves the PLL constraints for an input and output frequency in hertz, at compile time.
+//
+// The output frequency is M times the input frequency, and the current controlled oscillator runs at 2 * P times the
+// output frequency. The smallest post divider P which brings the oscillator into range is used, to save power.
+template <rtl::u32 input, rtl::u32 output> struct pll_solution {
+  static_assert(input >= 10000000 && input <= 25000000, "PLL input frequency must be between 10 and 25 MHz");
+  static_assert(output <= 100000000, "PLL output frequency must not exceed 100 MHz");
+  static_assert(output % input == 0, "PLL output frequency must be a multiple of its input frequency");
+
+  static constexpr auto m = output / input;
+
+  static_assert(m >= 1 && m <= 32, "PLL multiplier must be between 1 and 32");
+
+  static constexpr auto psel = pll_post_divider(output);
+
+  static_assert(psel < 4, "no post divider keeps the PLL oscillator between 156 and 320 MHz");
+
+  // SYSPLLCTRL value, with MSEL in bits 0-4 and PSEL in bits 5-6
+  static constexpr auto value = static_cast<rtl::u32>((m - 1) | (psel << 5));
+};
+
+}
+
 template <> class clock<clock_source::pll_out> {
 private:
   using SYSPLLCTRL = rtl::mmio<0x40048008, rtl::u32>;
@@ -87,29 +255,34 @@ private:
   using PDRUNCFG = rtl::mmio<0x40048238, rtl::u32>;
 
 public:
-  template <typename T> static auto frequency() {
+  template <typename T> static auto frequency() -> rtl::quantity<T, rtl::hertz> {
     auto m = SYSPLLCTRL::read<0b11111>() + 1;
 
     return m * clock<clock_source::pll_in>::frequency<T>();
   }
 
-  template <typename T> static auto enable(T frequency) {
-    // TODO: configure PLL accordingly somehow (this is probably incomplete)
-
-    auto frequency_in = clock<clock_source::pll_in>::frequency<rtl::u32>();
-
-    // calculate PLL parameters
-    auto m = frequency / frequency_in;                // M is the PLL multiplier
-    auto fcco = frequency_in * 2 * m;                 // FCCO is the internal PLL frequency
-
-    auto p = 0;
-
-    while (fcco < 156_MHz) {
-      fcco = fcco * 2;
-      p++;                                // find P which gives FCCO in the allowed range (over 156MHz)
+  /// @brief Locks the PLL to the given output frequency in hertz, from the given input clock.
+  ///
+  /// @remarks The PLL configuration is solved at compile time; unsupported frequencies fail compilation. The input
+  ///          frequency is taken from \c clock_rate, which the application must specialize for the system oscillator.
+  ///
+  /// @remarks Unless the PLL already runs with the given configuration, it is powered down while it is reprogrammed,
+  ///          so it must not drive the main clock.
+  template <clock_source input, rtl::u32 frequency> static auto enable() {
+    constexpr auto configuration = detail::pll_solution<clock_rate<input>::value, frequency>::value;
+
+    // a software reset may leave the PLL running and locked, in which case relocking it is a waste of time
+    if (PDRUNCFG::none<0b10000000>() && SYSPLLSTAT::all<0b1>() && SYSPLLCTRL::read<0b1111111>() == configuration
+        && clock<clock_source::pll_in>::source() == input) {
+      return;
     }
 
-    SYSPLLCTRL::write<0b111111>((m.template as<rtl::dimensionless>() - 1) | p << 5);
+    // the lock bit keeps reading 1 from a previous lock until the PLL is powered down, so it is powered down while
+    // it is reprogrammed, then waited on once it has been powered up again
+    PDRUNCFG::set<0b10000000>(); // power-down PLL
+
+    clock<clock_source::pll_in>::set_source(input);
+    SYSPLLCTRL::write<0b1111111>(configuration);
     PDRUNCFG::clear<0b10000000>(); // power-up PLL
 
     while (SYSPLLSTAT::none<0b1>());    // wait for PLL lock
@@ -120,23 +293,58 @@ public:
   }
 };
 
+namespace detail {
+
+// @brief Returns the minimum flash access time, in system clocks minus one, for the given clock frequency in hertz.
+constexpr auto flash_wait_states(rtl::u32 frequency) -> rtl::u32 {
+  if (frequency <= 20000000) {
+    return 0;
+  } else if (frequency <= 40000000) {
+    return 1;
+  } else {
+    return 2;
+  }
+}
+
+}
+
 /// @brief The main system-wide clock.
 ///
 /// @remarks This clock cannot be powered down while the system is running.
+///
+/// @remarks Changing the source of this clock also programs the flash access time, which must be long enough for the
+///          clock frequency: it is raised before switching to a faster clock and lowered after switching to a slower
+///          one, so that it always has the smallest legal value. This assumes that the core clock is not divided.
 template <> class clock<clock_source::main> {
 private:
   using MAINCLKSEL = rtl::mmio<0x40048070, rtl::u32>;
   using MAINCLKUEN = rtl::mmio<0x40048074, rtl::u32>;
+  using FLASHCFG = rtl::mmio<0x4003C010, rtl::u32>;
+
+  static auto frequency_of(clock_source source) -> rtl::u32 {
+    switch (source) {
+      case clock_source::irc:
+        return clock<clock_source::irc>::frequency<rtl::u32>().as<rtl::hertz>();
+      case clock_source::pll_in:
+        return clock<clock_source::pll_in>::frequency<rtl::u32>().as<rtl::hertz>();
+      case clock_source::pll_out:
+        return clock<clock_source::pll_out>::frequency<rtl::u32>().as<rtl::hertz>();
+      case clock_source::watchdog_osc:
+        return clock<clock_source::watchdog_osc>::frequency<rtl::u32>().as<rtl::hertz>();
+      default:
+        return 0;
+    }
+  }
 
 public:
-  template <typename T> static auto frequency() {
+  template <typename T> static auto frequency() -> rtl::quantity<T, rtl::hertz> {
     switch (MAINCLKSEL::read<0b11>()) {
       case 0b00:
         return clock<clock_source::irc>::frequency<T>();
       case 0b01:
         return clock<clock_source::pll_in>::frequency<T>();
       case 0b10:
-        //return clock<clock_source::watchdog_osc>::frequency();
+        return clock<clock_source::watchdog_osc>::frequency<T>();
       case 0b11:
         return clock<clock_source::pll_out>::frequency<T>();
       default:
@@ -145,6 +353,12 @@ public:
   }
 
   static auto set_source(clock_source source) {
+    auto wait_states = detail::flash_wait_states(frequency_of(source));
+
+    if (wait_states > FLASHCFG::read<0b11>()) {
+      FLASHCFG::write<0b11>(wait_states);
+    }
+
     switch (source) {
       case clock_source::irc:
         MAINCLKSEL::write<0b11>(0b00);
@@ -164,13 +378,18 @@ public:
 
     MAINCLKUEN::write<0b1>(0b0);
     MAINCLKUEN::write<0b1>(0b1);
+
+    if (wait_states < FLASHCFG::read<0b11>()) {
+      FLASHCFG::write<0b11>(wait_states);
+    }
   }
 };
 
 /// @brief The UART peripheral clock.
+///
+/// @remarks The clock of the UART register interface is gated separately, by \c power_lease<peripheral::uart>.
 template <> class clock<clock_source::uart> {
 private:
-  using SYSAHBCLKCTRL= rtl::mmio<0x40048080, rtl::u32>;
   using UARTCLKDIV = rtl::mmio<0x40048098, rtl::u32>;
 
 public:
@@ -179,6 +398,10 @@ public:
     return clock<clock_source::main>::frequency<T>() / divider;
   }
 
+  static auto divider() -> rtl::u8 {
+    return static_cast<rtl::u8>(UARTCLKDIV::read<0b11111111>());
+  }
+
   static auto set_divider(rtl::u8 divider) {
     rtl::assert(divider != 0, TRACE("UART clock enabled with zero divider"));
     UARTCLKDIV::write<0b11111111>(divider);
@@ -186,11 +409,153 @@ public:
 
   static auto enable(rtl::u8 divider = 1) {
     set_divider(divider);
-    SYSAHBCLKCTRL::set_bit<12>();
   }
 
   static auto disable() {
-    SYSAHBCLKCTRL::clear_bit<12>();
+    UARTCLKDIV::write<0b11111111>(0);
+  }
+};
+
+/// @brief The watchdog timer clock.
+///
+/// @remarks The clock of the watchdog register interface is gated separately, by \c power_lease<peripheral::watchdog>.
+template <> class clock<clock_source::watchdog> {
+private:
+  using WDTCLKSEL = rtl::mmio<0x400480D0, rtl::u32>;
+  using WDTCLKUEN = rtl::mmio<0x400480D4, rtl::u32>;
+  using WDTCLKDIV = rtl::mmio<0x400480D8, rtl::u32>;
+
+public:
+  template <typename T> static auto frequency() -> rtl::quantity<T, rtl::hertz> {
+    auto divider = WDTCLKDIV::read<0b11111111>();
+
+    if (divider == 0) {
+      return rtl::quantity<T, rtl::hertz>{T{0}};
+    }
+
+    switch (WDTCLKSEL::read<0b11>()) {
+      case 0b00:
+        return clock<clock_source::irc>::frequency<T>().template in<rtl::hertz>() / divider;
+      case 0b01:
+        return clock<clock_source::main>::frequency<T>() / divider;
+      case 0b10:
+        return clock<clock_source::watchdog_osc>::frequency<T>() / divider;
+      default:
+        rtl::unreachable(TRACE("invalid clock configuration"));
+    }
+  }
+
+  static auto set_source(clock_source source) {
+    switch (source) {
+      case clock_source::irc:
+        WDTCLKSEL::write<0b11>(0b00);
+        break;
+      case clock_source::main:
+        WDTCLKSEL::write<0b11>(0b01);
+        break;
+      case clock_source::watchdog_osc:
+        WDTCLKSEL::write<0b11>(0b10);
+        break;
+      default:
+        rtl::assert(false, TRACE("invalid clock source provided"));
+    }
+
+    WDTCLKUEN::write<0b1>(0b0);
+    WDTCLKUEN::write<0b1>(0b1);
+  }
+
+  static auto enable(clock_source source, rtl::u8 divider = 1) {
+    rtl::assert(divider != 0, TRACE("watchdog clock enabled with zero divider"));
+
+    set_source(source);
+    WDTCLKDIV::write<0b11111111>(divider);
+  }
+
+  static auto disable() {
+    WDTCLKDIV::write<0b11111111>(0);
+  }
+};
+
+/// @brief The clock output, which can be routed to \c pin::CLKOUT with a \c clock_output.
+template <> class clock<clock_source::clkout> {
+private:
+  using CLKOUTCLKSEL = rtl::mmio<0x400480E0, rtl::u32>;
+  using CLKOUTUEN = rtl::mmio<0x400480E4, rtl::u32>;
+  using CLKOUTDIV = rtl::mmio<0x400480E8, rtl::u32>;
+
+public:
+  template <typename T> static auto frequency() -> rtl::quantity<T, rtl::hertz> {
+    auto divider = CLKOUTDIV::read<0b11111111>();
+
+    if (divider == 0) {
+      return rtl::quantity<T, rtl::hertz>{T{0}};
+    }
+
+    switch (CLKOUTCLKSEL::read<0b11>()) {
+      case 0b00:
+        return clock<clock_source::irc>::frequency<T>().template in<rtl::hertz>() / divider;
+      case 0b01:
+        return clock<clock_source::system>::frequency<T>() / divider;
+      case 0b10:
+        return clock<clock_source::watchdog_osc>::frequency<T>() / divider;
+      case 0b11:
+        return clock<clock_source::main>::frequency<T>() / divider;
+      default:
+        rtl::unreachable(TRACE("invalid clock configuration"));
+    }
+  }
+
+  static auto set_source(clock_source source) {
+    switch (source) {
+      case clock_source::irc:
+        CLKOUTCLKSEL::write<0b11>(0b00);
+        break;
+      case clock_source::system:
+        CLKOUTCLKSEL::write<0b11>(0b01);
+        break;
+      case clock_source::watchdog_osc:
+        CLKOUTCLKSEL::write<0b11>(0b10);
+        break;
+      case clock_source::main:
+        CLKOUTCLKSEL::write<0b11>(0b11);
+        break;
+      default:
+        rtl::assert(false, TRACE("invalid clock source provided"));
+    }
+
+    CLKOUTUEN::write<0b1>(0b0);
+    CLKOUTUEN::write<0b1>(0b1);
+  }
+
+  static auto enable(clock_source source, rtl::u8 divider = 1) {
+    rtl::assert(divider != 0, TRACE("clock output enabled with zero divider"));
+
+    set_source(source);
+    CLKOUTDIV::write<0b11111111>(divider);
+  }
+
+  static auto disable() {
+    CLKOUTDIV::write<0b11111111>(0);
+  }
+};
+
+/// @brief Drives \c pin::CLKOUT with a clock source divided by the given divider, for as long as it lives.
+///
+/// \code
+/// auto output = dev::clock_output{dev::clock_source::system, 4};
+/// \endcode
+class clock_output : private rtl::noncopyable {
+private:
+  using pin_t = physical_io<pin::CLKOUT>;
+  pin_t output_pin{pin_t::clkout_options::none};
+
+public:
+  clock_output(clock_source source, rtl::u8 divider = 1) {
+    clock<clock_source::clkout>::enable(source, divider);
+  }
+
+  ~clock_output() {
+    clock<clock_source::clkout>::disable();
   }
 };
 
@@ -0,0 +1,143 @@
+#pragma once
+
+/// @file
+///
+/// @brief Clock tree descriptions for the LPC1100 series microcontrollers.
+///
+/// Drivers which derive timings from a clock frequency take a clock tree type, which tells them how to obtain it. The
+/// \c dynamic_clock_tree reads the clock configuration registers whenever a frequency is needed, and works whatever the
+/// application programmed. A \c static_clock_tree instead describes the whole configuration at compile time, so every
+/// frequency is a constant and the divisors computed from it fold away:
+///
+/// \code
+/// using clocks = dev::static_clock_tree<dev::clock_source::pll_out, 48000000>;
+///
+/// clocks::apply();
+/// auto uart = dev::uart0(9600_Hz, clocks{});
+/// \endcode
+///
+/// The application is responsible for keeping the hardware configured as described once \c apply has been called.
+
+#include <rtl/base.hpp>
+#include <rtl/mmio.hpp>
+#include <rtl/units.hpp>
+#include <hal/lpc1100/clock.hpp>
+
+namespace hal::lpc1100 {
+
+/// @brief Frequencies of the clocks which drivers derive their timings from, in hertz.
+struct clock_frequencies {
+  rtl::u32 main;
+  rtl::u32 core;
+};
+
+/// @brief Clock tree which reads the clock configuration from the hardware.
+struct dynamic_clock_tree {
+  template <clock_source node> static auto frequency() {
+    return clock<node>::template frequency<rtl::u32>();
+  }
+
+  /// @brief Divider applied to the main clock by the UART peripheral clock.
+  static constexpr rtl::u8 uart_divider = 1;
+
+  /// @brief Whether drivers on this clock tree follow frequency scaling, which they do as it reads the hardware.
+  static constexpr auto frequency_scaled = true;
+};
+
+namespace detail {
+
+// @brief Frequencies of the clock tree applied last, starting from the IRC oscillator out of reset.
+inline clock_frequencies current_frequencies{clock_rate<clock_source::irc>::value,
+                                             clock_rate<clock_source::irc>::value};
+
+// @brief Computes the frequency of a node of a static clock tree, or zero if the tree does not describe it.
+constexpr auto static_clock_rate(clock_source node, clock_source main_source, rtl::u32 main_frequency,
+                                 clock_source pll_source, rtl::u32 pll_frequency_in, rtl::u8 core_divider,
+                                 rtl::u8 uart_divider) -> rtl::u32 {
+  switch (node) {
+    case clock_source::irc:
+      return clock_rate<clock_source::irc>::value;
+    case clock_source::system:
+      return (pll_source == clock_source::system) ? pll_frequency_in : 0;
+    case clock_source::pll_in:
+      return pll_frequency_in;
+    case clock_source::pll_out:
+      return (main_source == clock_source::pll_out) ? main_frequency : 0;
+    case clock_source::main:
+      return main_frequency;
+    case clock_source::core:
+      return main_frequency / core_divider;
+    case clock_source::uart:
+      return main_frequency / uart_divider;
+    default:
+      return 0;
+  }
+}
+
+}
+
+/// @brief Clock tree described at compile time.
+///
+/// @tparam main_source The source of the main clock, either the IRC oscillator, the PLL input or the PLL output.
+/// @tparam main_frequency The frequency of the main clock in hertz, which is the PLL output frequency if it is used.
+/// @tparam core_divider The divider from the main clock to the core (AHB) clock.
+/// @tparam uart_clock_divider The divider from the main clock to the UART peripheral clock.
+/// @tparam pll_source The input of the PLL, whose rate is taken from \c clock_rate; a crystal on the system oscillator is
+///                    started by \c apply if it is used.
+template <clock_source main_source, rtl::u32 main_frequency, rtl::u8 core_divider = 1, rtl::u8 uart_clock_divider = 1,
+          clock_source pll_source = clock_source::irc>
+struct static_clock_tree {
+private:
+  using SYSAHBCLKDIV = rtl::mmio<0x40048078, rtl::u32>;
+
+  static constexpr auto pll_frequency_in = clock_rate<pll_source>::value;
+
+  static_assert(main_source == clock_source::irc || main_source == clock_source::pll_in
+                || main_source == clock_source::pll_out, "unsupported main clock source");
+  static_assert(pll_source == clock_source::irc || pll_source == clock_source::system, "unsupported PLL input");
+  static_assert(core_divider != 0 && uart_clock_divider != 0, "clock dividers must be nonzero");
+  static_assert(main_source != clock_source::irc || main_frequency == clock_rate<clock_source::irc>::value,
+                "main clock frequency does not match the IRC oscillator");
+  static_assert(main_source != clock_source::pll_in || main_frequency == pll_frequency_in,
+                "main clock frequency does not match the PLL input");
+
+public:
+  /// @brief Frequency of a node of the clock tree in hertz, as an \c std::integral_constant.
+  template <clock_source node> struct rate : std::integral_constant<rtl::u32, detail::static_clock_rate(
+    node, main_source, main_frequency, pll_source, pll_frequency_in, core_divider, uart_clock_divider)> {
+    static_assert(rate::value != 0, "clock not described by this clock tree");
+  };
+
+  template <clock_source node> static constexpr auto frequency() {
+    return rtl::quantity<rtl::u32, rtl::hertz>{rate<node>::value};
+  }
+
+  /// @brief Divider applied to the main clock by the UART peripheral clock.
+  static constexpr rtl::u8 uart_divider = uart_clock_divider;
+
+  static constexpr auto main_clock_source = main_source;
+
+  /// @brief Whether drivers on this clock tree follow frequency scaling; see \c frequency_scaled_clock_tree.
+  static constexpr auto frequency_scaled = false;
+
+  /// @brief Programs the clock configuration registers to match this clock tree, and records its frequencies as those
+  ///        of the current operating point.
+  static auto apply() {
+    if constexpr (pll_source == clock_source::system && main_source != clock_source::irc) {
+      clock<clock_source::system>::template enable<pll_frequency_in>();
+    }
+
+    if constexpr (main_source == clock_source::pll_out) {
+      clock<clock_source::pll_out>::template enable<pll_source, main_frequency>();
+    } else if constexpr (main_source == clock_source::pll_in) {
+      clock<clock_source::pll_in>::set_source(pll_source);
+    }
+
+    clock<clock_source::main>::set_source(main_source);
+    SYSAHBCLKDIV::write<0b11111111>(core_divider);
+
+    detail::current_frequencies = clock_frequencies{rate<clock_source::main>::value, rate<clock_source::core>::value};
+  }
+};
+
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+/// @file
+///
+/// @brief Timer-driven input debouncing for the LPC1100 series microcontrollers.
+///
+/// A \c debouncer samples every GPIO port holding one of its inputs from the periodic interrupt of a 32-bit timer, and
+/// only accepts a new level on an input once it has been sampled four times in a row:
+///
+/// \code
+/// auto button = dev::digital_input<dev::pin::PIO0_7>{termination::pullup};
+/// auto inputs = dev::debouncer<dev::peripheral::ct32b1, dev::pin::PIO0_7>{button, 2_ms};
+///
+/// inputs.wait_change<dev::pin::PIO0_7>().wait();
+/// auto level = inputs.state<dev::pin::PIO0_7>();
+/// \endcode
+///
+/// Each port is debounced as a whole with a two-bit vertical counter, whose bits are spread over two words so that the
+/// twelve counters of a port advance together in a few bitwise operations. The cost of a sample therefore depends on
+/// the number of ports used, and not on the number of inputs.
+
+#include <rtl/base.hpp>
+#include <rtl/mmio.hpp>
+#include <rtl/intrinsics.hpp>
+#include <rtl/units.hpp>
+#include <rtl/waitable.hpp>
+#include <hal/digital_io.hpp>
+#include <hal/lpc1100/digital_io.hpp>
+#include <hal/lpc1100/pin_interrupt.hpp>
+#include <hal/lpc1100/ticks.hpp>
+#include <hal/lpc1100/timer.hpp>
+
+namespace hal::lpc1100 {
+
+namespace detail {
+
+// @brief Two-bit vertical counters for the twelve pins of a port, with the stable levels they debounce.
+struct vertical_counter {
+  rtl::u32 stable;
+  rtl::u32 count0;
+  rtl::u32 count1;
+
+  // @brief Advances the counters of the pins whose sample differs from their stable level, resets the others, and
+  //        returns the pins whose counter wrapped around, which take the sampled level.
+  constexpr auto update(rtl::u32 sample) {
+    auto differs = sample ^ stable;
+
+    count1 = (count1 ^ count0) & differs;
+    count0 = ~count0 & differs;
+
+    auto changed = differs & ~(count0 | count1);
+    stable ^= changed;
+
+    return changed;
+  }
+};
+
+}
+
+/// @brief Waitable completing when the debounced level of any of a set of inputs changes.
+template <typename Debouncer> class debounce_event : private rtl::noncopyable {
+public:
+  debounce_event(Debouncer& debouncer, std::size_t port, rtl::u32 mask)
+    : changes(debouncer.changes[port]), mask(mask) {
+    rtl::intrinsics::non_preemptible([&]() {
+      changes = changes & ~mask;
+    });
+  }
+
+  debounce_event(debounce_event<Debouncer>&& other) = delete;
+  debounce_event<Debouncer>& operator=(debounce_event&& other) = delete;
+
+  auto is_complete() const {
+    return (changes & mask) != 0;
+  }
+
+  auto is_failed() const {
+    return false;
+  }
+
+  auto is_pending() const {
+    return !is_complete();
+  }
+
+  auto wait() const {
+    return rtl::waitable::wait_all(*this);
+  }
+
+private:
+  volatile rtl::u32& changes;
+  rtl::u32 mask;
+};
+
+/// @brief Debounces a set of digital inputs for as long as it lives.
+///
+/// @tparam timer The 32-bit counter/timer whose interrupt samples the inputs, which the debouncer owns.
+template <peripheral timer, pin... pins> class debouncer : private rtl::noncopyable {
+  static_assert(sizeof...(pins) != 0, "debouncer without pins");
+
+public:
+  /// @brief Starts sampling the inputs at the given period; a change is accepted after four periods.
+  ///
+  /// @remarks The inputs are only taken to ensure the pins are configured as such; they must outlive the debouncer.
+  template <typename T, typename Dimension>
+  debouncer(const digital_input<pins>&..., rtl::quantity<T, Dimension> sample_period) {
+    using core_ticks = ticks<detail::dependent_source<clock_source::core, T>>;
+
+    sample_all([this](std::size_t port, rtl::u32 sample) {
+      counters[port] = {sample, 0, 0};
+    });
+
+    clock.template every<debouncer, &debouncer::sample>(
+      rtl::quantity<rtl::u32, Dimension>{sample_period}.template as<core_ticks>(), *this);
+  }
+
+  debouncer(debouncer&& other) = delete;
+  debouncer& operator=(debouncer&& other) = delete;
+
+  /// @brief Returns the debounced level of an input.
+  template <pin pin> auto state() const {
+    using line = detail::gpio_line<pin>;
+    static_assert(((pin == pins) || ...), "pin is not debounced");
+
+    rtl::intrinsics::compiler_barrier(); // the levels are updated from the timer interrupt
+    return (counters[line::port].stable & (rtl::u32{1} << line::bit)) ? hal::logic_level::high
+                                                                      : hal::logic_level::low;
+  }
+
+  /// @brief Returns a waitable completing on the next change of the debounced level of an input.
+  template <pin pin> [[nodiscard]] auto wait_change() {
+    using line = detail::gpio_line<pin>;
+    static_assert(((pin == pins) || ...), "pin is not debounced");
+
+    return debounce_event<debouncer>{*this, line::port, rtl::u32{1} << line::bit};
+  }
+
+private:
+  friend class debounce_event<debouncer>;
+
+  static constexpr auto port_mask(std::size_t port) {
+    return ((detail::gpio_line<pins>::port == port ? rtl::u32{1} << detail::gpio_line<pins>::bit : 0) | ... | 0);
+  }
+
+  template <std::size_t port, typename Fn> auto sample_port(Fn&& fn) {
+    constexpr auto mask = port_mask(port);
+
+    if constexpr (mask != 0) {
+      // the address bits of the data register select which pins are read, and the others read as zero
+      fn(port, rtl::mmio_ro<detail::gpio_base(port) + 4 * mask, rtl::u32>::read());
+    }
+  }
+
+  template <typename Fn> auto sample_all(Fn&& fn) {
+    sample_port<0>(fn);
+    sample_port<1>(fn);
+    sample_port<2>(fn);
+    sample_port<3>(fn);
+  }
+
+  void sample() {
+    sample_all([this](std::size_t port, rtl::u32 sample) {
+      changes[port] = changes[port] | counters[port].update(sample);
+    });
+  }
+
+  timer32<timer> clock;
+  detail::vertical_counter counters[4]{};
+  volatile rtl::u32 changes[4]{};
+};
+
+}
@@ -13,6 +13,8 @@
 
 #include <hal/digital_io.hpp>
 #include <hal/lpc1100/physical_io.hpp>
+#include <hal/lpc1100/pin_interrupt.hpp>
+#include <hal/lpc1100/power.hpp>
 
 namespace hal::lpc1100 {
 
@@ -21,30 +23,6 @@ namespace hal::lpc1100 {
 
 namespace digital_io_detail {
 
-// inline auto SYSAHBCLKCTRL() { return rtl::mmio<rtl::u32>{0x40048080}; }
-
-// move this general resource management stuff to a separate class
-// which can monitor exactly which resources are used and turn the clocks on and off accordingly?
-// this would have to be an internal object somehow
-
-//static inline int gpio_refcount = 0;
-
-inline auto acquire_gpio() {
-  /*rtl::intrinsics::non_preemptible([](){
-    if (gpio_refcount++ == 0) {
-      SYSAHBCLKCTRL().set_bit<6>();
-    }
-  });*/
-}
-
-inline auto release_gpio() {
-  /*rtl::intrinsics::non_preemptible([](){
-    if (--gpio_refcount == 0) {
-      SYSAHBCLKCTRL().clear_bit<6>();
-    }
-  });*/
-}
-
 template <pin pin, rtl::uptr gpio_ptr, std::size_t port_no>
 class basic_digital_input : public hal::digital_input<basic_digital_input<pin, gpio_ptr, port_no>>,
                             private hal::lpc1100::physical_io<pin> {
@@ -54,19 +32,26 @@ public:
 
   basic_digital_input(termination termination, options options = options::none)
     : hal::lpc1100::physical_io<pin>(termination, options) {
-    acquire_gpio();
     DIR::template clear<port_mask>();
   }
 
-  ~basic_digital_input() {
-    release_gpio();
-  }
-
   auto state() {
     return DATA::read() ? hal::logic_level::high : hal::logic_level::low;
   }
 
+  /// @brief Returns a waitable completing on the next edge of the pin.
+  [[nodiscard]] auto wait_edge(edge edge) {
+    return pin_event<detail::gpio_line<pin>>{edge};
+  }
+
+  /// @brief Returns a waitable completing as soon as the pin is at the given level, which may be immediately.
+  [[nodiscard]] auto wait_level(hal::logic_level level) {
+    return pin_event<detail::gpio_line<pin>>{level};
+  }
+
 private:
+  power_lease<peripheral::gpio> power;
+
   static constexpr auto port_mask = 1 << port_no;
 
   using DATA = rtl::mmio<gpio_ptr + 4 * port_mask, rtl::u32>;
@@ -81,14 +66,12 @@ public:
 
   basic_digital_output(hal::logic_level initial_level, options options = options::none)
     : hal::lpc1100::physical_io<pin>(options) {
-    acquire_gpio();
     DIR::template set<port_mask>();
     this->drive(initial_level);
   }
 
   ~basic_digital_output() {
     DIR::template clear<port_mask>();
-    release_gpio();
   }
 
   auto drive_low() {
@@ -100,6 +83,8 @@ public:
   }
 
 private:
+  power_lease<peripheral::gpio> power;
+
   static constexpr auto port_mask = 1 << port_no;
 
   using DATA = rtl::mmio<gpio_ptr + 4 * port_mask, rtl::u32>;
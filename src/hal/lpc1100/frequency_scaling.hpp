@@ -0,0 +1,143 @@
+#pragma once
+
+/// @file
+///
+/// @brief Dynamic frequency scaling for the LPC1100 series microcontrollers.
+///
+/// The system moves between operating points, each of which is a \c static_clock_tree, for instance running from the
+/// IRC oscillator while idle and from the PLL in bursts of activity:
+///
+/// \code
+/// dev::frequency_scaling::switch_to<dev::operating_point::pll_48mhz>();
+/// \endcode
+///
+/// Drivers whose timings depend on a clock frequency subscribe a \c clock_listener, which is notified of the new
+/// frequencies as part of every switch, so that they can recompute their divisors before any interrupt is handled. They
+/// only do so on the \c dynamic_clock_tree or on a \c frequency_scaled_clock_tree; drivers on a plain
+/// \c static_clock_tree keep the divisors computed at compile time.
+///
+/// @remarks Durations converted at compile time through \c ticks and \c delay assume a fixed core clock, and are not
+///          adjusted by frequency scaling.
+
+#include <rtl/base.hpp>
+#include <rtl/functional.hpp>
+#include <rtl/intrinsics.hpp>
+#include <hal/lpc1100/clock.hpp>
+#include <hal/lpc1100/clock_tree.hpp>
+#include <hal/lpc1100/ticks.hpp>
+
+namespace hal::lpc1100 {
+
+/// @brief Predefined operating points.
+namespace operating_point {
+
+using irc_12mhz = static_clock_tree<clock_source::irc, 12000000>;
+using pll_24mhz = static_clock_tree<clock_source::pll_out, 24000000>;
+using pll_48mhz = static_clock_tree<clock_source::pll_out, 48000000>;
+
+}
+
+/// @brief Static clock tree whose drivers follow frequency scaling.
+///
+/// Drivers only subscribe to frequency changes on clock trees which ask for it, so that those on a plain
+/// \c static_clock_tree keep divisors which fold away. A driver started on this tree takes its initial divisors from
+/// \c Tree, and recomputes them at every switch between operating points.
+template <typename Tree> struct frequency_scaled_clock_tree : Tree {
+  static constexpr auto frequency_scaled = true;
+};
+
+/// @brief Subscription to clock frequency changes.
+///
+/// @remarks The callback runs with interrupts disabled, right after the clocks have been switched, and must only
+///          reprogram the peripheral; it must not wait for anything.
+class clock_listener : private rtl::noncopyable {
+private:
+  using context_t = rtl::interrupt_context<const clock_frequencies&>;
+
+public:
+  /// @brief Creates a listener which is not bound to any object yet.
+  clock_listener() {}
+
+  /// @brief Creates a listener calling the \c clock_changed member function of the given object.
+  template <typename T> explicit clock_listener(T& object)
+    : callback(context_t::template member_function<T, &T::clock_changed>, &object) {}
+
+  /// @brief Binds the listener to the \c clock_changed member function of the given object.
+  template <typename T> auto bind(T& object) {
+    callback = {context_t::template member_function<T, &T::clock_changed>, &object};
+  }
+
+private:
+  friend class frequency_scaling;
+
+  context_t callback;
+  clock_listener* next{nullptr};
+};
+
+/// @brief Result of a switch between operating points.
+struct frequency_switch {
+  /// @brief SysTick cycles taken by the switch, including any PLL lock time; the cycles before the switch are counted
+  ///        at the old core clock frequency and the cycles after it at the new one.
+  rtl::u32 cycles;
+};
+
+/// @brief Moves the system between operating points.
+class frequency_scaling {
+public:
+  static auto subscribe(clock_listener& listener) {
+    rtl::intrinsics::non_preemptible([&]() {
+      listener.next = listeners;
+      listeners = &listener;
+    });
+  }
+
+  static auto unsubscribe(clock_listener& listener) {
+    rtl::intrinsics::non_preemptible([&]() {
+      for (auto link = &listeners; *link != nullptr; link = &(*link)->next) {
+        if (*link == &listener) {
+          *link = listener.next;
+          break;
+        }
+      }
+    });
+  }
+
+  /// @brief Returns the clock frequencies of the current operating point, which is the clock tree applied last.
+  static auto frequencies() {
+    return detail::current_frequencies;
+  }
+
+  /// @brief Switches to the given operating point and notifies every listener.
+  ///
+  /// @remarks The main clock temporarily runs from the IRC oscillator while the PLL is reconfigured, as it cannot be
+  ///          changed while it drives the main clock; interrupts remain disabled until the PLL has locked. The PLL is
+  ///          powered down at operating points which do not use it. Flash wait states follow the main clock.
+  template <typename OperatingPoint> static auto switch_to() {
+    auto start = cycle_counter::now();
+
+    rtl::intrinsics::non_preemptible([]() {
+      constexpr auto uses_pll = (OperatingPoint::main_clock_source == clock_source::pll_out);
+
+      if constexpr (uses_pll) {
+        clock<clock_source::main>::set_source(clock_source::irc);
+      }
+
+      OperatingPoint::apply();
+
+      if constexpr (!uses_pll) {
+        clock<clock_source::pll_out>::disable();
+      }
+
+      for (auto listener = listeners; listener != nullptr; listener = listener->next) {
+        listener->callback(detail::current_frequencies);
+      }
+    });
+
+    return frequency_switch{cycle_counter::since(start)};
+  }
+
+private:
+  static inline clock_listener* listeners = nullptr;
+};
+
+}
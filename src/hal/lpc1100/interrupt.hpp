@@ -2,7 +2,6 @@
 
 // TODO: remove
 #include <hal/lpc1114/headers/LPC11xx.h>
-#include <hal/lpc1114/headers/hdr_syscon.h>
 
 /// @file
 ///
@@ -15,7 +14,13 @@ namespace hal::lpc1100 {
 namespace interrupt {
 
 enum class type {
-  uart = 21
+  ct32b0 = 18,
+  ct32b1 = 19,
+  uart = 21,
+  pio3 = 28,
+  pio2 = 29,
+  pio1 = 30,
+  pio0 = 31
 };
 
 inline void enable(type type) {
@@ -47,7 +52,13 @@ inline void default_(void)
     rtl::assert(false, TRACE("default handler hit"));
 }
 
+extern void ct32b0(void);
+extern void ct32b1(void);
 extern void uart(void);
+extern void pio0(void);
+extern void pio1(void);
+extern void pio2(void);
+extern void pio3(void);
 
 extern "C" const char __LD_STACK_TOP;
 
@@ -86,8 +97,8 @@ static inline interrupt::handler_t vectors[] __attribute__((used)) section(".vec
   interrupt::handlers::default_,                     // I2C interrupt
   interrupt::handlers::default_,               // CT16B0 (16-bit Timer0) interrupt
   interrupt::handlers::default_,               // CT16B1 (16-bit Timer1) interrupt
-  interrupt::handlers::default_,               // CT32B0 (32-bit Timer0) interrupt
-  interrupt::handlers::default_,               // CT32B1 (32-bit Timer1) interrupt
+  interrupt::handlers::ct32b0,                 // CT32B0 (32-bit Timer0) interrupt
+  interrupt::handlers::ct32b1,                 // CT32B1 (32-bit Timer1) interrupt
   interrupt::handlers::default_,                    // SPI/SSP0 interrupt
   interrupt::handlers::uart,                    // UART interrupt
   nullptr,            // Reserved 0x98
@@ -96,10 +107,10 @@ static inline interrupt::handler_t vectors[] __attribute__((used)) section(".vec
   interrupt::handlers::default_,                     // Watchdog timer interrupt
   interrupt::handlers::default_,                     // Brown Out Detect interrupt
   nullptr,            // Reserved 0xAC
-  interrupt::handlers::default_,                 // PIO INT3 interrupt
-  interrupt::handlers::default_,                 // PIO INT2 interrupt
-  interrupt::handlers::default_,                 // PIO INT1 interrupt
-  interrupt::handlers::default_                 // PIO INT0 interrupt
+  interrupt::handlers::pio3,                     // PIO INT3 interrupt
+  interrupt::handlers::pio2,                     // PIO INT2 interrupt
+  interrupt::handlers::pio1,                     // PIO INT1 interrupt
+  interrupt::handlers::pio0                      // PIO INT0 interrupt
 };
 
 }
@@ -7,17 +7,13 @@
 #include <rtl/base.hpp>
 #include <rtl/mmio.hpp>
 #include <rtl/bitflags.hpp>
-
-// TODO: LPC_SYSCON->SYSAHBCLKCTRL
-// this is the register where we need to enable the IOCON clock to make any of these changes
-// make sure to enable it here? (and disable it after the writes)
-// maybe we need a free function here that wraps an IOCON "operation" - it could take a lambda?
+#include <hal/lpc1100/power.hpp>
 
 namespace hal::lpc1100 {
 
 enum class pin {
   PIO0_0   =   0, RESET = 0,
-  PIO0_1   =   1, CLKOUT = 1, CT32B0_MAT2 = 2,
+  PIO0_1   =   1, CLKOUT = 1, CT32B0_MAT2 = 1,
   PIO0_2   =   2, SSEL0 = 2, CT16B0_CAP0 = 2,
   PIO0_3   =   3,
   PIO0_4   =   4, SCL = 4,
@@ -61,767 +57,219 @@ enum class pin {
   none
 };
 
-template <pin pin> class physical_io;
-
-namespace {
-  enum class basic_termination : rtl::u32 {
-    none     = 0b00 << 3,
-    pulldown = 0b01 << 3,
-    pullup   = 0b10 << 3,
-    repeater = 0b11 << 3
-  };
-
-  enum class basic_digital_input_options : rtl::u32 {
-    none = 0,
-    hysteresis = 0b1 << 5
-  };
-
-  enum class basic_digital_output_options : rtl::u32 {
-    none = 0
-  };
+/// @brief Peripheral functions which a pin can be switched to by a \c physical_io.
+enum class peripheral_function {
+  clkout,         ///< Clock output
+  uart_rx,        ///< UART receive data
+  uart_tx,        ///< UART transmit data
+  uart_rts,       ///< UART request to send
+  uart_cts,       ///< UART clear to send
+  ct32b0_cap0,    ///< 32-bit counter/timer 0 capture input 0
+  ct32b1_cap0     ///< 32-bit counter/timer 1 capture input 0
 };
 
 namespace detail {
-  template <rtl::uptr address> struct iocon_register {
-  public:
-    template <rtl::u32 mask> static auto write(rtl::u32 value) {
-      SYSAHBCLKCTRL::set_bit<16>();
-      IOCON::template write<mask>(value);
-      SYSAHBCLKCTRL::clear_bit<16>();
-    }
 
-  private:
-    using SYSAHBCLKCTRL = rtl::mmio<0x40048080, rtl::u32>;
-    using IOCON = rtl::mmio<address, rtl::u32>;
-  };
-};
+// @brief Number of alternate peripheral functions recorded per pin.
+constexpr auto max_alternates = std::size_t{2};
+
+struct pin_alternate {
+  peripheral_function function;
+  rtl::u8 code;   // IOCON function number, zero for unused entries
+};
+
+// @brief Capabilities of a pin.
+struct pin_capabilities {
+  rtl::u8 iocon_offset;         // offset of the IOCON register from the IOCON base address
+  rtl::u8 gpio_code;            // IOCON function number selecting GPIO
+  rtl::u8 adc_code;             // IOCON function number selecting the ADC input, zero if there is none
+  bool i2c;                     // true open-drain I2C pad, without pull resistors, with an I2C mode
+  pin_alternate alternates[max_alternates];
+};
+
+constexpr auto iocon_base = rtl::uptr{0x40044000};
+
+// @brief Capabilities of every pin, indexed by pin number.
+constexpr pin_capabilities pin_database[] = {
+  /* PIO0_0  */ {0x0C, 1, 0, false, {}},
+  /* PIO0_1  */ {0x10, 0, 0, false, {{peripheral_function::clkout, 1}}},
+  /* PIO0_2  */ {0x1C, 0, 0, false, {}},
+  /* PIO0_3  */ {0x2C, 0, 0, false, {}},
+  /* PIO0_4  */ {0x30, 0, 0, true,  {}},
+  /* PIO0_5  */ {0x34, 0, 0, true,  {}},
+  /* PIO0_6  */ {0x4C, 0, 0, false, {}},
+  /* PIO0_7  */ {0x50, 0, 0, false, {{peripheral_function::uart_cts, 1}}},
+  /* PIO0_8  */ {0x60, 0, 0, false, {}},
+  /* PIO0_9  */ {0x64, 0, 0, false, {}},
+  /* PIO0_10 */ {0x68, 1, 0, false, {}},
+  /* PIO0_11 */ {0x74, 1, 2, false, {}},
+  /* PIO1_0  */ {0x78, 1, 2, false, {{peripheral_function::ct32b1_cap0, 3}}},
+  /* PIO1_1  */ {0x7C, 1, 2, false, {}},
+  /* PIO1_2  */ {0x80, 1, 2, false, {}},
+  /* PIO1_3  */ {0x90, 1, 2, false, {}},
+  /* PIO1_4  */ {0x94, 0, 1, false, {}},
+  /* PIO1_5  */ {0xA0, 0, 0, false, {{peripheral_function::uart_rts, 1}, {peripheral_function::ct32b0_cap0, 2}}},
+  /* PIO1_6  */ {0xA4, 0, 0, false, {{peripheral_function::uart_rx, 1}}},
+  /* PIO1_7  */ {0xA8, 0, 0, false, {{peripheral_function::uart_tx, 1}}},
+  /* PIO1_8  */ {0x14, 0, 0, false, {}},
+  /* PIO1_9  */ {0x38, 0, 0, false, {}},
+  /* PIO1_10 */ {0x6C, 0, 1, false, {}},
+  /* PIO1_11 */ {0x98, 0, 1, false, {}},
+  /* PIO2_0  */ {0x08, 0, 0, false, {}},
+  /* PIO2_1  */ {0x28, 0, 0, false, {}},
+  /* PIO2_2  */ {0x5C, 0, 0, false, {}},
+  /* PIO2_3  */ {0x8C, 0, 0, false, {}},
+  /* PIO2_4  */ {0x40, 0, 0, false, {}},
+  /* PIO2_5  */ {0x44, 0, 0, false, {}},
+  /* PIO2_6  */ {0x00, 0, 0, false, {}},
+  /* PIO2_7  */ {0x20, 0, 0, false, {}},
+  /* PIO2_8  */ {0x24, 0, 0, false, {}},
+  /* PIO2_9  */ {0x54, 0, 0, false, {}},
+  /* PIO2_10 */ {0x58, 0, 0, false, {}},
+  /* PIO2_11 */ {0x70, 0, 0, false, {}},
+  /* PIO3_0  */ {0x84, 0, 0, false, {}},
+  /* PIO3_1  */ {0x88, 0, 0, false, {}},
+  /* PIO3_2  */ {0x9C, 0, 0, false, {}},
+  /* PIO3_3  */ {0xAC, 0, 0, false, {}},
+  /* PIO3_4  */ {0x3C, 0, 0, false, {}},
+  /* PIO3_5  */ {0x48, 0, 0, false, {}}
+};
+
+static_assert(sizeof(pin_database) / sizeof(pin_database[0]) == static_cast<std::size_t>(pin::none),
+              "every pin must be described in the pin database");
+
+constexpr auto& capabilities_of(pin pin) {
+  return pin_database[static_cast<std::size_t>(pin)];
+}
 
-template <> class physical_io<pin::PIO0_0> {
-private:
-  using IOCON = detail::iocon_register<0x4004400C>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
+constexpr auto iocon_address(pin pin) {
+  return iocon_base + capabilities_of(pin).iocon_offset;
+}
 
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b001 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
+// @brief Returns the IOCON function number selecting a peripheral function on a pin, or zero if it has none.
+constexpr auto function_code(pin pin, peripheral_function function) -> rtl::u32 {
+  for (const auto& alternate : capabilities_of(pin).alternates) {
+    if (alternate.code != 0 && alternate.function == function) {
+      return alternate.code;
+    }
   }
 
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b001 | static_cast<rtl::u32>(options));
-  }
-};
+  return 0;
+}
 
-template <> class physical_io<pin::PIO0_1> {
-private:
-  using IOCON = detail::iocon_register<0x40044010>;
+template <rtl::uptr address> struct iocon_register {
 public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
+  template <rtl::u32 mask> static auto write(rtl::u32 value) {
+    auto power = power_lease<peripheral::iocon>{};
+    IOCON::template write<mask>(value);
   }
-};
 
-template <> class physical_io<pin::PIO0_2> {
 private:
-  using IOCON = detail::iocon_register<0x4004401C>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
+  using IOCON = rtl::mmio<address, rtl::u32>;
 };
 
-template <> class physical_io<pin::PIO0_3> {
-private:
-  using IOCON = detail::iocon_register<0x4004402C>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
+}
 
-template <> class physical_io<pin::PIO0_4> {
-private:
-  using IOCON = detail::iocon_register<0x40044030>;
-public:
-  enum class termination : rtl::u32 {
-    none = 0
+namespace {
+  enum class basic_termination : rtl::u32 {
+    none     = 0b00 << 3,
+    pulldown = 0b01 << 3,
+    pullup   = 0b10 << 3,
+    repeater = 0b11 << 3
   };
 
-  using digital_input_options = basic_digital_input_options;
-  
-  physical_io(termination /* termination */, digital_input_options options) {
-    IOCON::write<0b1100000111>(0b000 | static_cast<rtl::u32>(options) | (0b01 << 8));
-  }
-};
+  enum class basic_digital_input_options : rtl::u32 {
+    none = 0,
+    hysteresis = 0b1 << 5
+  };
 
-template <> class physical_io<pin::PIO0_5> {
-private:
-  using IOCON = detail::iocon_register<0x40044034>;
-public:
-  enum class termination : rtl::u32 {
+  enum class basic_digital_output_options : rtl::u32 {
     none = 0
   };
 
-  using digital_input_options = basic_digital_input_options;
-  
-  physical_io(termination /* termination */, digital_input_options options) {
-    IOCON::write<0b1100000111>(0b000 | static_cast<rtl::u32>(options) | (0b01 << 8));
-  }
-};
-
-template <> class physical_io<pin::PIO0_6> {
-private:
-  using IOCON = detail::iocon_register<0x4004404C>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO0_7> {
-private:
-  using IOCON = detail::iocon_register<0x40044050>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO0_8> {
-private:
-  using IOCON = detail::iocon_register<0x40044060>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO0_9> {
-private:
-  using IOCON = detail::iocon_register<0x40044064>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO0_10> {
-private:
-  using IOCON = detail::iocon_register<0x40044068>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b001 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b001 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO0_11> {
-private:
-  using IOCON = detail::iocon_register<0x40044074>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b001 |static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b001 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO1_0> {
-private:
-  using IOCON = detail::iocon_register<0x40044078>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b001 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b001 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO1_1> {
-private:
-  using IOCON = detail::iocon_register<0x4004407C>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b001 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b001 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO1_2> {
-private:
-  using IOCON = detail::iocon_register<0x40044080>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b001 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b001 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO1_3> {
-private:
-  using IOCON = detail::iocon_register<0x40044090>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b001 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b001 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO1_4> {
-private:
-  using IOCON = detail::iocon_register<0x40044094>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b001 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b001 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO1_5> {
-private:
-  using IOCON = detail::iocon_register<0x400440A0>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO1_6> {
-private:
-  using IOCON = detail::iocon_register<0x400440A4>;
-public:
-  enum class uart_rx_options {
+  enum class i2c_termination : rtl::u32 {
     none = 0
   };
 
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(uart_rx_options /*options*/) {
-    IOCON::write<0b111>(0b001);
-  }
-};
-
-template <> class physical_io<pin::PIO1_7> {
-private:
-  using IOCON = detail::iocon_register<0x400440A8>;
-public:
-  enum class uart_tx_options {
+  enum class i2c_digital_input_options : rtl::u32 {
     none = 0
   };
-
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(uart_tx_options /*options*/) {
-    IOCON::write<0b111>(0b001);
-  }
-};
-
-template <> class physical_io<pin::PIO1_8> {
-private:
-  using IOCON = detail::iocon_register<0x40044014>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO1_9> {
-private:
-  using IOCON = detail::iocon_register<0x40044038>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO1_10> {
-private:
-  using IOCON = detail::iocon_register<0x4004406C>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b001 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b001 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO1_11> {
-private:
-  using IOCON = detail::iocon_register<0x40044098>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO2_0> {
-private:
-  using IOCON = detail::iocon_register<0x40044008>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(
-      0b000 |
-      static_cast<rtl::u32>(options)
-    );
-  }
-};
-
-template <> class physical_io<pin::PIO2_1> {
-private:
-  using IOCON = detail::iocon_register<0x40044028>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO2_2> {
-private:
-  using IOCON = detail::iocon_register<0x4004405C>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO2_3> {
-private:
-  using IOCON = detail::iocon_register<0x4004408C>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO2_4> {
-private:
-  using IOCON = detail::iocon_register<0x40044040>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO2_5> {
-private:
-  using IOCON = detail::iocon_register<0x40044044>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO2_6> {
-private:
-  using IOCON = detail::iocon_register<0x40044000>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO2_7> {
-private:
-  using IOCON = detail::iocon_register<0x40044020>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO2_8> {
-private:
-  using IOCON = detail::iocon_register<0x40044024>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
 };
 
-template <> class physical_io<pin::PIO2_9> {
-private:
-  using IOCON = detail::iocon_register<0x40044054>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
-
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO2_10> {
+/// @brief Configures the IOCON register of a physical pin, as described by the pin database.
+///
+/// Every pin can be configured as a digital input or output; the I2C pins, being open-drain, only as inputs. The pin
+/// can also be switched to one of its peripheral functions by constructing it from the corresponding options type, for
+/// instance \c uart_tx_options, which fails compilation if the pin does not provide that function.
+template <pin pin> class physical_io {
 private:
-  using IOCON = detail::iocon_register<0x40044058>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
+  static constexpr auto capabilities = detail::capabilities_of(pin);
 
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
+  using IOCON = detail::iocon_register<detail::iocon_address(pin)>;
 
-template <> class physical_io<pin::PIO2_11> {
-private:
-  using IOCON = detail::iocon_register<0x40044070>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
+  template <peripheral_function function> static auto select() {
+    constexpr auto code = detail::function_code(pin, function);
+    static_assert(code != 0, "pin does not provide this peripheral function");
 
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
+    IOCON::template write<0b111>(code);
   }
-};
 
-template <> class physical_io<pin::PIO3_0> {
-private:
-  using IOCON = detail::iocon_register<0x40044084>;
 public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
+  using termination = std::conditional_t<capabilities.i2c, i2c_termination, basic_termination>;
+  using digital_input_options = std::conditional_t<capabilities.i2c, i2c_digital_input_options,
+                                                   basic_digital_input_options>;
   using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
 
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
+  enum class clkout_options { none = 0 };
+  enum class uart_rx_options { none = 0 };
+  enum class uart_tx_options { none = 0 };
+  enum class uart_rts_options { none = 0 };
+  enum class uart_cts_options { none = 0 };
+  enum class capture_options { none = 0 };
 
-template <> class physical_io<pin::PIO3_1> {
-private:
-  using IOCON = detail::iocon_register<0x40044088>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
   physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
+    if constexpr (capabilities.i2c) {
+      // standard GPIO mode, no I2C glitch filter or slew rate control
+      IOCON::template write<0b1100000111>(capabilities.gpio_code | static_cast<rtl::u32>(options) | (0b01 << 8));
+    } else {
+      IOCON::template write<0b111111>(capabilities.gpio_code | static_cast<rtl::u32>(termination)
+                                      | static_cast<rtl::u32>(options));
+    }
   }
 
   physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
-  }
-};
-
-template <> class physical_io<pin::PIO3_2> {
-private:
-  using IOCON = detail::iocon_register<0x4004409C>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
-  }
+    static_assert(!capabilities.i2c, "the I2C pins cannot drive their output high, use them as inputs");
 
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
+    IOCON::template write<0b111>(capabilities.gpio_code | static_cast<rtl::u32>(options));
   }
-};
 
-template <> class physical_io<pin::PIO3_3> {
-private:
-  using IOCON = detail::iocon_register<0x400440AC>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
+  physical_io(clkout_options /*options*/) {
+    select<peripheral_function::clkout>();
   }
 
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
+  physical_io(uart_rx_options /*options*/) {
+    select<peripheral_function::uart_rx>();
   }
-};
 
-template <> class physical_io<pin::PIO3_4> {
-private:
-  using IOCON = detail::iocon_register<0x4004403C>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
+  physical_io(uart_tx_options /*options*/) {
+    select<peripheral_function::uart_tx>();
   }
 
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
+  physical_io(uart_rts_options /*options*/) {
+    select<peripheral_function::uart_rts>();
   }
-};
 
-template <> class physical_io<pin::PIO3_5> {
-private:
-  using IOCON = detail::iocon_register<0x40044048>;
-public:
-  using termination = basic_termination;
-  using digital_input_options = basic_digital_input_options;
-  using digital_output_options = basic_digital_output_options;
-  
-  physical_io(termination termination, digital_input_options options) {
-    IOCON::write<0b111111>(0b000 | static_cast<rtl::u32>(termination) | static_cast<rtl::u32>(options));
+  physical_io(uart_cts_options /*options*/) {
+    select<peripheral_function::uart_cts>();
   }
 
-  physical_io(digital_output_options options) {
-    IOCON::write<0b111>(0b000 | static_cast<rtl::u32>(options));
+  /// @brief Switches the pin to the capture input of a 32-bit counter/timer.
+  physical_io(capture_options /*options*/) {
+    if constexpr (detail::function_code(pin, peripheral_function::ct32b0_cap0) != 0) {
+      select<peripheral_function::ct32b0_cap0>();
+    } else {
+      select<peripheral_function::ct32b1_cap0>();
+    }
   }
 };
 
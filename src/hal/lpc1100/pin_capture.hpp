@@ -0,0 +1,103 @@
+#pragma once
+
+/// @file
+///
+/// @brief Timestamped pin change capture for the LPC1100 series microcontrollers.
+///
+/// A \c pin_capture records every edge on a set of digital inputs, together with the count of a 32-bit timer, into a
+/// ring which the application drains in bulk, for instance to send it over the UART:
+///
+/// \code
+/// auto input = dev::digital_input<dev::pin::PIO0_7>{termination::pullup};
+/// auto capture = dev::pin_capture<dev::peripheral::ct32b0, 256, dev::pin::PIO0_7>{input};
+///
+/// dev::pin_change changes[32];
+/// auto count = capture.drain(changes, 32);
+/// \endcode
+///
+/// Each edge is recorded by the GPIO port interrupt handler in constant time: reading the timer and the pin level and
+/// pushing one item, besides the dispatch itself. This bounds the edge rate which can be captured; edges closer
+/// together than the handler takes to run are merged, and edges arriving while the ring is full are dropped and
+/// counted.
+///
+/// @remarks Timestamps are taken when the handler runs, so they include the interrupt latency, which is constant unless
+///          another interrupt is being handled. The level is read at the same time, and may already reflect a later
+///          edge. For the exact timing of a single signal, use the capture inputs of the counter/timers instead.
+
+#include <rtl/base.hpp>
+#include <rtl/assert.hpp>
+#include <rtl/functional.hpp>
+#include <rtl/ring.hpp>
+#include <hal/digital_io.hpp>
+#include <hal/lpc1100/digital_io.hpp>
+#include <hal/lpc1100/pin_interrupt.hpp>
+#include <hal/lpc1100/power.hpp>
+#include <hal/lpc1100/timer.hpp>
+
+namespace hal::lpc1100 {
+
+/// @brief Edge recorded by a \c pin_capture.
+struct pin_change {
+  rtl::u32 time;            ///< Timer count when the edge was handled
+  pin source;               ///< Pin the edge occurred on
+  hal::logic_level level;   ///< Level of the pin when the edge was handled
+};
+
+/// @brief Records the edges of a set of digital inputs for as long as it lives.
+///
+/// @tparam timer The 32-bit counter/timer providing the timestamps, which the capture owns; an assert trips if another
+///               owner, such as a \c debouncer, already holds it.
+/// @tparam capacity The number of edges the ring holds, which must be a power of two.
+template <peripheral timer, std::size_t capacity, pin... pins> class pin_capture : private rtl::noncopyable {
+  static_assert(sizeof...(pins) != 0, "capture without pins");
+
+public:
+  /// @brief Starts capturing, with the timer incrementing once every \p prescale core clock cycles.
+  ///
+  /// @remarks The inputs are only taken to ensure the pins are configured as such; they must outlive the capture.
+  explicit pin_capture(const digital_input<pins>&..., rtl::u32 prescale = 1) : clock(prescale) {
+    (listen<pins>(), ...);
+  }
+
+  pin_capture(pin_capture&& other) = delete;
+  pin_capture& operator=(pin_capture&& other) = delete;
+
+  ~pin_capture() {
+    (detail::gpio_line<pins>::disarm(), ...);
+  }
+
+  /// @brief Moves up to \p count of the oldest recorded edges into \p out, returning how many.
+  auto drain(pin_change* out, std::size_t count) {
+    return changes.pop(out, count);
+  }
+
+  /// @brief Returns the number of edges dropped because the ring was full.
+  auto dropped() const {
+    return overruns;
+  }
+
+private:
+  template <pin pin> auto listen() {
+    using line = detail::gpio_line<pin>;
+
+    rtl::assert(!line::listener().valid(), TRACE("pin already has a pending event"));
+
+    line::listener() = {rtl::interrupt_context<>::member_function<pin_capture, &pin_capture::changed<pin>>, this};
+    line::arm(false, true, false);
+  }
+
+  template <pin pin> void changed() {
+    auto time = timer32<timer>::now();
+    auto level = detail::gpio_line<pin>::DATA::read() ? hal::logic_level::high : hal::logic_level::low;
+
+    if (!changes.push(pin_change{time, pin, level})) {
+      overruns = overruns + 1;
+    }
+  }
+
+  timer32<timer> clock;
+  rtl::ring<pin_change, capacity> changes;
+  volatile rtl::u32 overruns{0};
+};
+
+}
@@ -0,0 +1,54 @@
+#include <hal/lpc1100/pin_interrupt.hpp>
+
+// The port interrupt handlers, which dispatch each pending pin interrupt to its listener. They are defined here rather
+// than next to the drivers so that the vector table always links, whether or not the application uses pin events.
+
+namespace hal::lpc1100
+{
+
+rtl::interrupt_context<> detail::pin_listeners[4][12]{};
+
+namespace {
+
+template <std::size_t port> void dispatch() {
+  using IE = rtl::mmio<detail::gpio_base(port) + 0x8010, rtl::u32>;
+  using MIS = rtl::mmio_ro<detail::gpio_base(port) + 0x8018, rtl::u32>;
+  using IC = rtl::mmio_wo<detail::gpio_base(port) + 0x801C, rtl::u32>;
+
+  // the edge detectors take a few cycles to clear, so they are cleared before dispatching rather than on the way out
+  auto pending = MIS::read();
+  IC::write(pending);
+
+  while (pending != 0) {
+    auto bit = rtl::intrinsics::count_trailing_zeros(pending);
+    auto& listener = detail::pin_listeners[port][bit];
+
+    if (listener.valid()) {
+      listener();
+    } else {
+      IE::write(IE::read() & ~(rtl::u32{1} << bit));
+    }
+
+    pending &= pending - 1;
+  }
+}
+
+}
+
+ramfunc void interrupt::handlers::pio0(void) {
+  dispatch<0>();
+}
+
+ramfunc void interrupt::handlers::pio1(void) {
+  dispatch<1>();
+}
+
+ramfunc void interrupt::handlers::pio2(void) {
+  dispatch<2>();
+}
+
+ramfunc void interrupt::handlers::pio3(void) {
+  dispatch<3>();
+}
+
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+/// @file
+///
+/// @brief GPIO pin interrupts for the LPC1100 series microcontrollers.
+///
+/// A digital input can wait for an edge or a level on its pin instead of polling it, sleeping until the port interrupt
+/// fires:
+///
+/// \code
+/// auto input = dev::digital_input<dev::pin::PIO0_7>{termination::pullup};
+/// input.wait_edge(dev::edge::falling).wait();
+/// \endcode
+///
+/// Each \c pin_event is one-shot: its pin interrupt is enabled while it is pending and masked again as soon as it
+/// completes, so it is never re-entered. At most one event may be pending per pin at any given time.
+///
+/// @remarks The start logic wake-up interrupts, which only matter in deep-sleep mode, are not used.
+
+#include <rtl/base.hpp>
+#include <rtl/mmio.hpp>
+#include <rtl/assert.hpp>
+#include <rtl/functional.hpp>
+#include <rtl/intrinsics.hpp>
+#include <rtl/waitable.hpp>
+#include <hal/digital_io.hpp>
+#include <hal/lpc1100/interrupt.hpp>
+#include <hal/lpc1100/physical_io.hpp>
+
+namespace hal::lpc1100 {
+
+/// @brief Signal edges a pin interrupt can trigger on.
+enum class edge {
+  rising,
+  falling,
+  both
+};
+
+namespace detail {
+
+// @brief The pins are numbered in port order, twelve to a port.
+constexpr auto gpio_port(std::size_t pin_number) {
+  return pin_number / 12;
+}
+
+constexpr auto gpio_bit(std::size_t pin_number) {
+  return pin_number % 12;
+}
+
+constexpr auto gpio_base(std::size_t port) -> rtl::uptr {
+  return 0x50000000 + port * 0x10000;
+}
+
+// @brief Listener of every pin interrupt, by port and bit; defined with the port interrupt handlers.
+extern rtl::interrupt_context<> pin_listeners[4][12];
+
+// @brief Interrupt registers and listener of a GPIO pin.
+template <pin pin> struct gpio_line {
+  static constexpr auto pin_number = static_cast<std::size_t>(pin);
+  static constexpr auto port = gpio_port(pin_number);
+  static constexpr auto bit = gpio_bit(pin_number);
+
+  using IS = rtl::mmio<gpio_base(port) + 0x8004, rtl::u32>;
+  using IBE = rtl::mmio<gpio_base(port) + 0x8008, rtl::u32>;
+  using IEV = rtl::mmio<gpio_base(port) + 0x800C, rtl::u32>;
+  using IE = rtl::mmio<gpio_base(port) + 0x8010, rtl::u32>;
+  using IC = rtl::mmio_wo<gpio_base(port) + 0x801C, rtl::u32>;
+  using DATA = rtl::mmio_ro<gpio_base(port) + (4 << bit), rtl::u32>;
+
+  static constexpr interrupt::type irq[] = {
+    interrupt::type::pio0, interrupt::type::pio1, interrupt::type::pio2, interrupt::type::pio3
+  };
+
+  static auto& listener() {
+    return pin_listeners[port][bit];
+  }
+
+  // @brief Configures the trigger with the pin interrupt masked, so that changing it cannot raise a spurious event,
+  //        then unmasks it; the listener must already be set.
+  static auto arm(bool level, bool both_edges, bool high) {
+    rtl::intrinsics::non_preemptible([&]() {
+      IE::template clear_bit<bit>();
+
+      configure<IS>(level);
+      configure<IBE>(both_edges);
+      configure<IEV>(high);
+
+      IC::write(rtl::u32{1} << bit);
+      IE::template set_bit<bit>();
+    });
+
+    interrupt::enable(irq[port]);
+  }
+
+  static auto disarm() {
+    rtl::intrinsics::non_preemptible([]() {
+      IE::template clear_bit<bit>();
+    });
+
+    listener().reset();
+  }
+
+private:
+  template <typename Register> static auto configure(bool set) {
+    if (set) {
+      Register::template set_bit<bit>();
+    } else {
+      Register::template clear_bit<bit>();
+    }
+  }
+};
+
+}
+
+/// @brief Waitable completing on the next edge or level of a pin.
+template <typename Line> class pin_event : private rtl::noncopyable {
+public:
+  explicit pin_event(edge edge) : status(rtl::waitable::status::pending) {
+    arm(false, edge == edge::both, edge == edge::rising);
+  }
+
+  explicit pin_event(hal::logic_level level) : status(rtl::waitable::status::pending) {
+    arm(true, false, level == hal::logic_level::high);
+  }
+
+  pin_event(pin_event<Line>&& other) = delete;
+  pin_event<Line>& operator=(pin_event&& other) = delete;
+
+  ~pin_event() {
+    Line::disarm();
+  }
+
+  auto is_complete() const {
+    return status == rtl::waitable::status::complete;
+  }
+
+  auto is_failed() const {
+    return status == rtl::waitable::status::failed;
+  }
+
+  auto is_pending() const {
+    return status == rtl::waitable::status::pending;
+  }
+
+  auto interrupt() {
+    Line::IE::template clear_bit<Line::bit>();
+    status = rtl::waitable::status::complete;
+  }
+
+  auto wait() const {
+    return rtl::waitable::wait_all(*this);
+  }
+
+private:
+  auto arm(bool level, bool both_edges, bool high) {
+    rtl::assert(!Line::listener().valid(), TRACE("pin already has a pending event"));
+
+    Line::listener() = {rtl::interrupt_context<>::member_function<pin_event<Line>>, this};
+    Line::arm(level, both_edges, high);
+  }
+
+  volatile rtl::waitable::status status;
+};
+
+}
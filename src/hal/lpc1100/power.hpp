@@ -0,0 +1,116 @@
+#pragma once
+
+/// @file
+///
+/// @brief Peripheral clock gating and analog power control for the LPC1100 series microcontrollers.
+///
+/// Every driver holds a \c power_lease on the peripheral clocks and analog blocks it uses, for as long as it lives. The
+/// first lease on a power domain turns it on and the last one turns it off again, so that nothing draws current unless
+/// a driver needs it:
+///
+/// \code
+/// class driver {
+///   dev::power_lease<dev::peripheral::ct32b0> power;
+/// };
+/// \endcode
+///
+/// @remarks The oscillators and the PLL are not leased; they are part of the clock tree and are powered up and down by
+///          their \c clock specializations.
+
+#include <rtl/base.hpp>
+#include <rtl/mmio.hpp>
+#include <rtl/refcount.hpp>
+
+namespace hal::lpc1100 {
+
+/// @brief Peripherals whose register interface clock is gated, by bit position in SYSAHBCLKCTRL.
+enum class peripheral : rtl::u8 {
+  i2c      = 5,   ///< I2C controller
+  gpio     = 6,   ///< GPIO ports
+  ct16b0   = 7,   ///< 16-bit counter/timer 0
+  ct16b1   = 8,   ///< 16-bit counter/timer 1
+  ct32b0   = 9,   ///< 32-bit counter/timer 0
+  ct32b1   = 10,  ///< 32-bit counter/timer 1
+  ssp0     = 11,  ///< SPI controller 0
+  uart     = 12,  ///< UART
+  adc      = 13,  ///< Analog-to-digital converter
+  watchdog = 15,  ///< Watchdog timer
+  iocon    = 16,  ///< IO configuration block
+  ssp1     = 18   ///< SPI controller 1
+};
+
+/// @brief Analog blocks which can be powered down, by bit position in PDRUNCFG.
+enum class analog_block : rtl::u8 {
+  brownout = 3,   ///< Brown-out detector
+  adc      = 4    ///< Analog-to-digital converter
+};
+
+namespace detail {
+
+using SYSAHBCLKCTRL = rtl::mmio<0x40048080, rtl::u32>;
+using PDRUNCFG = rtl::mmio<0x40048238, rtl::u32>;
+
+// @brief Turns a power domain on and off, without counting its users.
+template <auto domain> struct power_switch {
+  static constexpr auto bit = static_cast<std::size_t>(domain);
+  static constexpr auto is_peripheral = std::is_same<decltype(domain), peripheral>::value;
+
+  static_assert(is_peripheral || std::is_same<decltype(domain), analog_block>::value, "not a power domain");
+
+  struct on {
+    auto operator()() const {
+      if constexpr (is_peripheral) {
+        SYSAHBCLKCTRL::set_bit<bit>();
+      } else {
+        PDRUNCFG::clear_bit<bit>();
+      }
+    }
+  };
+
+  struct off {
+    auto operator()() const {
+      if constexpr (is_peripheral) {
+        SYSAHBCLKCTRL::clear_bit<bit>();
+      } else {
+        PDRUNCFG::set_bit<bit>();
+      }
+    }
+  };
+};
+
+template <auto domain> inline rtl::resource<typename power_switch<domain>::on,
+                                            typename power_switch<domain>::off> power_domain{};
+
+}
+
+/// @brief Keeps a peripheral clock or analog block powered for as long as it lives.
+template <auto domain> class power_lease : private rtl::noncopyable {
+public:
+  power_lease() {
+    detail::power_domain<domain>.acquire();
+  }
+
+  ~power_lease() {
+    detail::power_domain<domain>.release();
+  }
+};
+
+/// @brief Returns the number of live leases on a power domain.
+template <auto domain> auto power_users() {
+  return detail::power_domain<domain>.users();
+}
+
+/// @brief Gates the peripheral clocks which are enabled at reset but have no lease.
+///
+/// @remarks The startup code calls this before \c main, so drivers must lease every peripheral they use.
+inline auto gate_unused_peripherals() {
+  if (power_users<peripheral::gpio>() == 0) {
+    detail::power_switch<peripheral::gpio>::off{}();
+  }
+
+  if (power_users<peripheral::ssp0>() == 0) {
+    detail::power_switch<peripheral::ssp0>::off{}();
+  }
+}
+
+}
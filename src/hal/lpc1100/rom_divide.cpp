@@ -0,0 +1,55 @@
+#include <rtl/platform.hpp>
+
+// The LPC1100XL parts (LPC111x/101, /102, /201, /202, /301 and /302 revisions) provide 32-bit integer division
+// routines in their boot ROM, which are considerably faster than a software divider. They are absent from earlier
+// parts, so this is opt-in: defining HAL_LPC1100_ROM_DIVIDE overrides the weak run-time ABI entry points of the RTL.
+
+#if defined(HAL_LPC1100_ROM_DIVIDE)
+
+namespace hal::lpc1100
+{
+
+namespace {
+
+struct rom_divide_api {
+  rtl::i32 (*sidiv)(rtl::i32 numerator, rtl::i32 denominator);
+  rtl::u32 (*uidiv)(rtl::u32 numerator, rtl::u32 denominator);
+  // the remaining entries return their result in memory, which does not match the run-time ABI, and are not used
+};
+
+struct rom_api_table {
+  const void* usb;
+  const void* clib;
+  const void* can;
+  const void* power;
+  const rom_divide_api* divide;
+};
+
+auto rom_divide() {
+  return (*reinterpret_cast<const rom_api_table* const*>(0x1FFF1FF8))->divide;
+}
+
+}
+
+}
+
+extern "C" rtl::u32 __aeabi_uidiv(rtl::u32 n, rtl::u32 d) {
+  return hal::lpc1100::rom_divide()->uidiv(n, d);
+}
+
+extern "C" rtl::u64 __aeabi_uidivmod(rtl::u32 n, rtl::u32 d) {
+  auto quotient = hal::lpc1100::rom_divide()->uidiv(n, d);
+  return (static_cast<rtl::u64>(n - quotient * d) << 32) | quotient;
+}
+
+extern "C" rtl::i32 __aeabi_idiv(rtl::i32 n, rtl::i32 d) {
+  return hal::lpc1100::rom_divide()->sidiv(n, d);
+}
+
+extern "C" rtl::u64 __aeabi_idivmod(rtl::i32 n, rtl::i32 d) {
+  auto quotient = static_cast<rtl::u32>(hal::lpc1100::rom_divide()->sidiv(n, d));
+  auto remainder = static_cast<rtl::u32>(n) - quotient * static_cast<rtl::u32>(d);
+  return (static_cast<rtl::u64>(remainder) << 32) | quotient;
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include <hal/lpc1100/system.hpp>
 
+#include <hal/lpc1100/power.hpp>
+#include <hal/lpc1100/ticks.hpp>
 #include <rtl/mmio.hpp>
 
 namespace hal::lpc1100
@@ -35,6 +37,11 @@ static reset_context determine_reset_event() {
     }
   }
 
+  // the runtime initialization started SysTick as a cycle counter before mapping memory
+  context.boot_cycles = cycle_counter::now();
+
+  gate_unused_peripherals();
+
   main(context);
 }
 
@@ -47,6 +47,9 @@ struct reset_context {
     assert_reset_info assert;
     software_reset_info software;
   };
+
+  /// @brief Core clock cycles elapsed between the reset and the call to \c main, measured by the SysTick timer.
+  rtl::u32 boot_cycles{0};
 };
 
 }
@@ -0,0 +1,103 @@
+#pragma once
+
+/// @file
+///
+/// @brief Hardware tick units for the LPC1100 series microcontrollers.
+///
+/// The application describes its clock tree at compile time by specializing \c clock_rate for every clock source it
+/// measures time against, typically the core clock which drives the SysTick timer and the counter/timers:
+///
+/// \code
+/// namespace hal::lpc1100 {
+/// template <> struct clock_rate<clock_source::core> : std::integral_constant<rtl::u32, 48000000> {};
+/// }
+/// \endcode
+///
+/// A \c ticks<source> quantity is then an ordinary time unit whose scale is one period of that clock, so converting
+/// durations such as \c 5_ms to and from tick counts is resolved entirely at compile time.
+
+#include <rtl/base.hpp>
+#include <rtl/mmio.hpp>
+#include <rtl/units.hpp>
+
+namespace hal::lpc1100 {
+
+/// @brief All clock sources available in the system.
+enum class clock_source {
+  irc,            ///< Internal IRC oscillator
+  system,         ///< External system crystal oscillator
+  pll_in,         ///< On-chip phase-locked loop input
+  pll_out,        ///< On-chip phase-locked loop output
+  watchdog_osc,   ///< Watchdog oscillator
+  watchdog,       ///< Watchdog clock
+  main,           ///< Main system-wide clock
+  core,           ///< Core clock (AHB)
+  clkout,         ///< CLKOUT source clock
+  uart            ///< UART peripheral clock
+};
+
+/// @brief Compile-time frequency of a clock source, in hertz.
+///
+/// @remarks Only the IRC oscillator has a fixed frequency; every other clock source must be specialized by the
+///          application to match the clock configuration it programs at startup.
+template <clock_source source> struct clock_rate;
+
+template <> struct clock_rate<clock_source::irc> : std::integral_constant<rtl::u32, 12000000> {};
+
+/// @brief Time unit equal to one period of the given clock source.
+template <clock_source source> using ticks = rtl::second::scaled<std::ratio<1, clock_rate<source>::value>>;
+
+namespace detail {
+
+using SYST_CSR = rtl::mmio<0xE000E010, rtl::u32>;
+using SYST_RVR = rtl::mmio<0xE000E014, rtl::u32>;
+using SYST_CVR = rtl::mmio<0xE000E018, rtl::u32>;
+
+constexpr auto systick_mask = rtl::u32{0xFFFFFF};
+
+// @brief Defers the lookup of an application-provided clock rate until a template using it is instantiated.
+template <clock_source source, typename> constexpr auto dependent_source = source;
+
+}
+
+/// @brief Free-running core clock cycle counter, built on the SysTick timer.
+///
+/// @remarks The counter is 24 bits wide, so only intervals shorter than 2^24 cycles can be measured. SysTick runs from
+///          the core clock with its full reload value and without interrupts once enabled.
+struct cycle_counter {
+  static auto enable() {
+    detail::SYST_RVR::write(detail::systick_mask);
+    detail::SYST_CVR::write(0);
+    detail::SYST_CSR::write(0b101);
+  }
+
+  static auto now() -> rtl::u32 {
+    return detail::systick_mask - detail::SYST_CVR::read<detail::systick_mask>();
+  }
+
+  static auto since(rtl::u32 start) -> rtl::u32 {
+    return (now() - start) & detail::systick_mask;
+  }
+};
+
+/// @brief Busy-waits for the given number of core clock cycles.
+inline auto delay_cycles(rtl::u32 cycles) {
+  cycle_counter::enable();
+  auto previous = cycle_counter::now();
+
+  while (cycles != 0) {
+    auto elapsed = cycle_counter::since(previous);
+    previous = (previous + elapsed) & detail::systick_mask;
+
+    cycles = (elapsed >= cycles) ? 0 : cycles - elapsed;
+  }
+}
+
+/// @brief Busy-waits for the given duration, rounded down to a whole number of core clock cycles.
+template <typename T, typename Dimension> auto delay(rtl::quantity<T, Dimension> duration) {
+  using core_ticks = ticks<detail::dependent_source<clock_source::core, T>>;
+
+  delay_cycles(rtl::quantity<rtl::u32, Dimension>{duration}.template as<core_ticks>());
+}
+
+}
@@ -0,0 +1,31 @@
+#include <hal/lpc1100/timer.hpp>
+
+// The match interrupt handlers of the 32-bit counter/timers, which acknowledge the interrupt and call the listener set
+// by timer32::every. As with the pin interrupts, they are defined here so that the vector table always links.
+
+namespace hal::lpc1100
+{
+
+rtl::interrupt_context<> detail::timer_listeners[2]{};
+
+namespace {
+
+template <rtl::uptr base, std::size_t index> void dispatch() {
+  rtl::mmio_wo<base + 0x00, rtl::u32>::write(0b1);
+
+  if (detail::timer_listeners[index].valid()) {
+    detail::timer_listeners[index]();
+  }
+}
+
+}
+
+ramfunc void interrupt::handlers::ct32b0(void) {
+  dispatch<0x40014000, 0>();
+}
+
+ramfunc void interrupt::handlers::ct32b1(void) {
+  dispatch<0x40018000, 1>();
+}
+
+}
@@ -5,6 +5,11 @@
 /// @brief Timer for LPC1100 series microcontrollers.
 
 #include <rtl/base.hpp>
+#include <rtl/mmio.hpp>
+#include <rtl/assert.hpp>
+#include <rtl/functional.hpp>
+#include <hal/lpc1100/interrupt.hpp>
+#include <hal/lpc1100/power.hpp>
 
 namespace hal::lpc1100 {
 
@@ -18,13 +23,85 @@ namespace hal::lpc1100 {
 // In terms of resource ownership, each timer can be owned by one owner at any given time. The templated variants exist
 // only to allow those unused match pins to be used for other purposes (e.g. GPIO).
 
-template <typename N> class timer32 {
+namespace detail {
+
+// @brief Listener of the match interrupt of each 32-bit counter/timer; defined with the interrupt handlers.
+extern rtl::interrupt_context<> timer_listeners[2];
+
+}
+
+/// @brief Free-running 32-bit counter/timer, counting core clock cycles through a prescaler.
+///
+/// @remarks Only the counting part and a periodic interrupt from match register 0 are implemented so far; the other
+///          match registers and the capture registers are left disabled.
+template <peripheral timer> class timer32 : private rtl::noncopyable {
+  static_assert(timer == peripheral::ct32b0 || timer == peripheral::ct32b1, "not a 32-bit counter/timer");
+
 public:
-  // TODO
+  /// @brief Starts counting from zero, incrementing once every \p prescale core clock cycles.
+  ///
+  /// @remarks Only one \c timer32 may own each counter/timer at any given time, which is checked by an assert.
+  explicit timer32(rtl::u32 prescale = 1) {
+    rtl::assert(!owned, TRACE("counter/timer already owned"));
+    owned = true;
+
+    TCR::write(0b10); // hold the counters in reset
+    CTCR::write(0);   // timer mode, counting on every peripheral clock edge
+    MCR::write(0);
+    PR::write(prescale - 1);
+    TCR::write(0b01);
+  }
+
+  ~timer32() {
+    if (listener().valid()) {
+      interrupt::disable(irq);
+      listener().reset();
+    }
+
+    TCR::write(0);
+    owned = false;
+  }
+
+  static auto now() -> rtl::u32 {
+    return TC::read();
+  }
+
+  /// @brief Restarts the count and calls the given member function of \p object from the timer interrupt every
+  ///        \p period counts, until the timer is destroyed.
+  template <typename T, void (T::*Fn)() = &T::interrupt> auto every(rtl::u32 period, T& object) {
+    rtl::assert(period != 0, TRACE("timer period must be nonzero"));
+
+    listener() = {rtl::interrupt_context<>::member_function<T, Fn>, &object};
+
+    TCR::write(0b10);
+    MR0::write(period - 1);
+    MCR::write(0b011); // interrupt and reset on match 0
+    IR::write(0b1);
+    TCR::write(0b01);
+
+    interrupt::enable(irq);
+  }
 
 private:
-  // TODO
+  power_lease<timer> power;
+
+  static inline bool owned = false;
+
+  static constexpr auto index = (timer == peripheral::ct32b0) ? 0 : 1;
+  static constexpr rtl::uptr base = (timer == peripheral::ct32b0) ? 0x40014000 : 0x40018000;
+  static constexpr auto irq = (timer == peripheral::ct32b0) ? interrupt::type::ct32b0 : interrupt::type::ct32b1;
+
+  static auto& listener() {
+    return detail::timer_listeners[index];
+  }
 
+  using IR = rtl::mmio<base + 0x00, rtl::u32>;
+  using TCR = rtl::mmio<base + 0x04, rtl::u32>;
+  using TC = rtl::mmio<base + 0x08, rtl::u32>;
+  using PR = rtl::mmio<base + 0x0C, rtl::u32>;
+  using MCR = rtl::mmio<base + 0x14, rtl::u32>;
+  using MR0 = rtl::mmio<base + 0x18, rtl::u32>;
+  using CTCR = rtl::mmio<base + 0x70, rtl::u32>;
 };
 
 }
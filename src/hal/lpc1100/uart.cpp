@@ -0,0 +1,21 @@
+#include <hal/lpc1100/uart.hpp>
+
+// The UART interrupt handler, which dispatches to the send or receive context of the UART. As with the timer and pin
+// interrupts, it is defined here so that the vector table always links, and out of line so that it can be placed in
+// RAM; an inline function is emitted in a group of its own, which cannot share the .ramtext section.
+
+namespace hal::lpc1100
+{
+
+ramfunc void interrupt::handlers::uart(void) {
+  auto iir = rtl::mmio_ro<0x40008008, rtl::u32>::read<0b1110>();
+
+  switch (iir) {
+    case 0b0010:
+      return uart0::send_context();
+    default:
+      return uart0::recv_context(iir);
+  }
+}
+
+}
@@ -6,9 +6,13 @@
 
 #include <hal/interface.hpp>
 #include <hal/lpc1100/physical_io.hpp>
+#include <hal/lpc1100/board.hpp>
 #include <rtl/mmio.hpp>
 #include <hal/lpc1100/interrupt.hpp>
 #include <hal/lpc1100/clock.hpp>
+#include <hal/lpc1100/clock_tree.hpp>
+#include <hal/lpc1100/frequency_scaling.hpp>
+#include <hal/lpc1100/power.hpp>
 
 // TODO: needs support for hardware flow control
 // (let's not bother with auto-baud or modem features)
@@ -18,10 +22,10 @@ namespace hal::lpc1100 {
 template <pin tx, pin rx> class uart : public hal::byte_interface<uart<tx, rx>> {
   friend void interrupt::handlers::uart(void);
 private:
+  power_lease<peripheral::uart> power;
+
   using tx_pin_t = typename hal::lpc1100::physical_io<tx>;
   using rx_pin_t = typename hal::lpc1100::physical_io<rx>;
-  tx_pin_t tx_pin{tx_pin_t::uart_tx_options::none};
-  rx_pin_t rx_pin{rx_pin_t::uart_rx_options::none};
 
   using LSR = rtl::mmio_ro<0x40008014, rtl::u32>;
   using IER = rtl::mmio_rw<0x40008004, rtl::u32>;
@@ -34,10 +38,27 @@ private:
   using FDR = rtl::mmio_rw<0x40008028, rtl::u8>;
 
 public:
-  template <typename T> uart(rtl::quantity<T, rtl::hertz> baud_rate) {
-    configure_uart(baud_rate);
+  /// @brief Configures the UART for the given baud rate, deriving its divisor from the given clock tree, and switches
+  ///        its pins to the UART.
+  template <typename T, typename Clocks = dynamic_clock_tree> uart(rtl::quantity<T, rtl::hertz> baud_rate,
+                                                                   Clocks = {})
+    : baud_hertz(baud_rate.template as<rtl::hertz>()) {
+    tx_pin_t{tx_pin_t::uart_tx_options::none};
+    rx_pin_t{rx_pin_t::uart_rx_options::none};
+
+    start<Clocks>(baud_rate);
+  }
 
-    interrupt::enable(interrupt::type::uart);
+  /// @brief Configures the UART for the given baud rate on the pins of a board, which must assign them to the UART.
+  template <typename... Pins, typename T, typename Clocks = dynamic_clock_tree>
+  uart(const board<Pins...>& /*board*/, rtl::quantity<T, rtl::hertz> baud_rate, Clocks = {})
+    : baud_hertz(baud_rate.template as<rtl::hertz>()) {
+    static_assert(board<Pins...>::template assigns_function<tx, peripheral_function::uart_tx>,
+                  "board does not assign the UART transmit pin");
+    static_assert(board<Pins...>::template assigns_function<rx, peripheral_function::uart_rx>,
+                  "board does not assign the UART receive pin");
+
+    start<Clocks>(baud_rate);
   }
 
   template <typename T> [[nodiscard]] auto write(const T& context) {
@@ -49,6 +70,7 @@ public:
   }
 
   ~uart() {
+    frequency_scaling::unsubscribe(listener);
     interrupt::disable(interrupt::type::uart);
     clock<clock_source::uart>::disable();
 
@@ -56,25 +78,49 @@ public:
     rtl::assert(!recv_context.valid(), TRACE("still receiving"));
   }
 
+  /// @brief Recomputes the baud rate divisor after a frequency change.
+  auto clock_changed(const clock_frequencies& frequencies) {
+    write_divisor(frequencies.main / clock<clock_source::uart>::divider() / 16 / baud_hertz);
+  }
+
 private:
+  rtl::u32 baud_hertz;
+  clock_listener listener;
+
   static inline rtl::interrupt_context<> send_context{};
   static inline rtl::interrupt_context<rtl::u32> recv_context{};
 
-  template <typename T> auto configure_uart(T baud_rate) {
-    clock<clock_source::uart>::enable(); // divider is 1
+  template <typename Clocks, typename T> auto start(T baud_rate) {
+    configure_uart<Clocks>(baud_rate);
+
+    // on a static clock tree, binding the listener would link in the runtime divisor computation
+    if constexpr (Clocks::frequency_scaled) {
+      listener.bind(*this);
+      frequency_scaling::subscribe(listener);
+    }
+
+    interrupt::enable(interrupt::type::uart);
+  }
+
+  template <typename Clocks, typename T> auto configure_uart(T baud_rate) {
+    clock<clock_source::uart>::enable(Clocks::uart_divider);
 
-    auto clock_hertz = clock<clock_source::uart>::frequency<rtl::u32>().in<rtl::hertz>();
+    auto clock_hertz = Clocks::template frequency<clock_source::uart>().template in<rtl::hertz>();
     auto divisor = (clock_hertz / 16 / baud_rate).template as<rtl::dimensionless>();
 
+    write_divisor(divisor);
+    FDR::write(0b00010000); // mul = 1, divadd = 0 (no fractional divider)
+
+    FCR::set<0b11000111>(); // 2 MSBs are the RX FIFO trigger level (here set to 0b11 = 14 characters)
+  }
+
+  static auto write_divisor(rtl::u32 divisor) {
     LCR::write(0b10000000); // enable latches
 
     DLM::write(divisor / 256);
     DLL::write(divisor % 256);
 
-    FDR::write(0b00010000); // mul = 1, divadd = 0 (no fractional divider)
     LCR::write(0b00000011); // 8 bit words, 1 stop bit, no parity, disable latches
-
-    FCR::set<0b11000111>(); // 2 MSBs are the RX FIFO trigger level (here set to 0b11 = 14 characters)
   }
 
   template <typename T> struct send_waitable : private rtl::noncopyable {
@@ -251,15 +297,4 @@ private:
 
 using uart0 = uart<pin::TXD, pin::RXD>;
 
-inline void interrupt::handlers::uart(void) {
-  auto iir = rtl::mmio_ro<0x40008008, rtl::u32>::read<0b1110>();
-
-  switch (iir) {
-    case 0b0010:
-      return uart0::send_context();
-    default:
-      return uart0::recv_context(iir);
-  }
-}
-
 }
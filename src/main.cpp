@@ -3,54 +3,42 @@
 #include <rtl/platform.hpp>
 
 #include <hal/lpc1114/headers/LPC11xx.h>
-#include <hal/lpc1114/headers/hdr_syscon.h>
 
 #include <hal/lpc1100/system.hpp>
-#include <hal/lpc1100/digital_io.hpp>
+#include <hal/lpc1100/board.hpp>
 #include <hal/lpc1100/uart.hpp>
 #include <rtl/assert.hpp>
 #include <hal/lpc1100/interrupt.hpp>
 #include <hal/lpc1100/clock.hpp>
+#include <hal/lpc1100/clock_tree.hpp>
+#include <hal/lpc1100/ticks.hpp>
 
 #include <sys/format.hpp>
 
-static void flash_access_time(uint32_t frequency);
-
-static void flash_access_time(uint32_t frequency)
-{
-    uint32_t access_time, flashcfg_register;
+namespace dev = hal::lpc1100;
 
-    if (frequency < 20000000ul)             // 1 system clock for core speed below 20MHz
-        access_time = FLASHCFG_FLASHTIM_1CLK;
-    else if (frequency < 40000000ul)        // 2 system clocks for core speed between 20MHz and 40MHz
-        access_time = FLASHCFG_FLASHTIM_2CLK;
-    else                                    // 3 system clocks for core speed over 40MHz
-        access_time = FLASHCFG_FLASHTIM_3CLK;
+using clocks = dev::static_clock_tree<dev::clock_source::pll_out, 48000000>;
 
-    // do not modify reserved bits in FLASHCFG register
-    flashcfg_register = FLASHCFG;           // read register
-    flashcfg_register &= ~(FLASHCFG_FLASHTIM_mask << FLASHCFG_FLASHTIM_bit);    // mask the FLASHTIM field
-    flashcfg_register |= access_time << FLASHCFG_FLASHTIM_bit;  // use new FLASHTIM value
-    FLASHCFG = flashcfg_register;           // save the new value back to the register
+namespace hal::lpc1100 {
+template <> struct clock_rate<clock_source::main> : clocks::rate<clock_source::main> {};
+template <> struct clock_rate<clock_source::core> : clocks::rate<clock_source::core> {};
 }
 
-namespace dev = hal::lpc1100;
-
-using assert_pin = dev::digital_output<dev::pin::PIO1_5>;
-using output_pin = dev::digital_output<dev::pin::PIO0_8>;
-using input_pin = dev::digital_input<dev::pin::PIO0_7>;
+using board = dev::board<dev::pin_function<dev::pin::TXD, dev::peripheral_function::uart_tx>,
+                         dev::pin_function<dev::pin::RXD, dev::peripheral_function::uart_rx>,
+                         dev::gpio_output<dev::pin::PIO1_5, hal::logic_level::low>,   // assert signal
+                         dev::gpio_output<dev::pin::PIO0_8, hal::logic_level::high>,  // heartbeat
+                         dev::gpio_input<dev::pin::PIO0_7, dev::iocon_pullup>>;
 
-void assert_signal() {
-  auto pin = assert_pin(hal::logic_level::high);
+void assert_signal(const board& pins) {
+  auto pin = pins.output<dev::pin::PIO1_5>();
 
   for (auto i = 0; i < 5; ++i) {
-    for (auto j = 0; j < 0x1FFFF; ++j) {
-      pin.drive_high();
-    }
+    pin.drive_high();
+    dev::delay(20_ms);
 
-    for (auto j = 0; j < 0x1FFFF; ++j) {
-      pin.drive_low();
-    }
+    pin.drive_low();
+    dev::delay(20_ms);
   }
 }
 
@@ -68,20 +56,13 @@ auto read_any() {
 }
 
 [[noreturn]] void main(const dev::reset_context& context) {
-  auto frequency = 48_MHz;
-  flash_access_time(48000000);           // configure flash access time first
-
-  // set the main clock
-  dev::clock<dev::clock_source::pll_in>::set_source(dev::clock_source::irc);
-  dev::clock<dev::clock_source::pll_out>::enable(frequency);
-  dev::clock<dev::clock_source::main>::set_source(dev::clock_source::pll_out);
-
-  LPC_SYSCON->SYSAHBCLKDIV = 1;           // set AHB clock divider to 1
+  auto pins = board{};
+  clocks::apply();
 
-  auto uart = dev::uart0(9600_Hz);
+  auto uart = dev::uart0(pins, 9600_Hz, clocks{});
 
   if (context.event == dev::reset_event::assert) {
-    assert_signal();
+    assert_signal(pins);
   }
 
   constexpr auto v1 = rtl::quantity<rtl::q32, rtl::gram>{5.0f};
@@ -105,19 +86,17 @@ auto read_any() {
   //uart.write(sys::format(std::pair{"", uart_clock.numerator()}, std::pair{"10s", "/"}, std::pair{"", uart_clock.denominator()})).wait();
   uart.write(sys::format(std::pair{"", uart_clock}, std::pair{"", "Hz"})).wait();
   uart.write(sys::format(std::pair{"", irc_clock}, std::pair{"", "MHz"})).wait();
+  uart.write(sys::format(std::pair{"", context.boot_cycles}, std::pair{"", " boot cycles"})).wait();
 
   rtl::assert<x + (y - x) - 2.5f <= x + x>("test");
 
-  auto output = output_pin(hal::logic_level::high);
-  auto input = input_pin(input_pin::termination::pullup);
+  auto output = pins.output<dev::pin::PIO0_8>();
 
   while (true) {
-    for (auto i = 0; i < 0x1FFFFF; ++i) {
-      output.drive_low();
-    }
+    output.drive_low();
+    dev::delay(250_ms);
 
-    for (auto i = 0; i < 0x1FFFFF; ++i) {
-      output.drive_high();
-    }
+    output.drive_high();
+    dev::delay(250_ms);
   }
 }
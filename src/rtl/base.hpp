@@ -21,6 +21,8 @@
 /// @endcond
 
 extern "C" void* memcpy(void* destination, const void* source, std::size_t num);
+extern "C" void* memmove(void* destination, const void* source, std::size_t num);
+extern "C" void* memset(void* destination, int value, std::size_t num);
 extern "C" int memcmp(const void* a, const void* b, std::size_t num);
 extern "C" size_t strlen(const char* str);
 
@@ -0,0 +1,256 @@
+#pragma once
+
+/// @file
+///
+/// @brief Range-tracked unit types.
+///
+/// A bounded quantity carries the closed interval its value is known to lie in as part of its type. Arithmetic on
+/// bounded quantities propagates these intervals at compile time, and every bounded quantity is stored in the smallest
+/// integer type able to represent its whole interval. Each operation is carried out in a type wide enough for both its
+/// operands and its result, so that it provably cannot overflow, and only widens to 64 bits when the ranges require.
+
+#include <rtl/base.hpp>
+#include <rtl/assert.hpp>
+#include <rtl/units.hpp>
+
+namespace rtl {
+
+namespace detail {
+
+template <typename T, i64 lo, i64 hi> constexpr auto fits_in = static_cast<i64>(std::numeric_limits<T>::min()) <= lo
+                                                             && hi <= static_cast<i64>(std::numeric_limits<T>::max());
+
+// @brief Smallest integer type able to represent every value in [lo, hi].
+template <i64 lo, i64 hi> struct storage_for {
+  using type = std::conditional_t<fits_in<i8, lo, hi>, i8,
+               std::conditional_t<fits_in<u8, lo, hi>, u8,
+               std::conditional_t<fits_in<i16, lo, hi>, i16,
+               std::conditional_t<fits_in<u16, lo, hi>, u16,
+               std::conditional_t<fits_in<i32, lo, hi>, i32,
+               std::conditional_t<fits_in<u32, lo, hi>, u32, i64>>>>>>;
+};
+
+template <i64 lo, i64 hi> using storage_for_t = typename storage_for<lo, hi>::type;
+
+constexpr auto min_of(i64 a, i64 b) { return (a < b) ? a : b; }
+constexpr auto max_of(i64 a, i64 b) { return (a < b) ? b : a; }
+
+constexpr auto add_overflows(i64 a, i64 b) {
+  return (b > 0) ? (a > std::numeric_limits<i64>::max() - b) : (a < std::numeric_limits<i64>::min() - b);
+}
+
+constexpr auto mul_overflows(i64 a, i64 b) {
+  if (a == 0 || b == 0) {
+    return false;
+  }
+
+  if ((a == -1 && b == std::numeric_limits<i64>::min()) || (b == -1 && a == std::numeric_limits<i64>::min())) {
+    return true;
+  }
+
+  auto product = static_cast<i64>(static_cast<u64>(a) * static_cast<u64>(b));
+  return product / b != a;
+}
+
+// @brief Locates an integer relative to [lo, hi], returning -1 if below, +1 if above and 0 if inside.
+//
+// @remarks The comparison is done in the value's own type whenever it can represent both bounds.
+template <i64 lo, i64 hi, typename T> constexpr int range_position(T value) {
+  static_assert(std::is_integral<T>::value, "bounded quantities must be integral");
+
+  if constexpr (fits_in<T, lo, hi>) {
+    return (value < static_cast<T>(lo)) ? -1 : (value > static_cast<T>(hi)) ? +1 : 0;
+  } else if constexpr (std::is_signed<T>::value) {
+    return (static_cast<i64>(value) < lo) ? -1 : (static_cast<i64>(value) > hi) ? +1 : 0;
+  } else if constexpr (hi < 0) {
+    return +1;
+  } else {
+    return (lo > 0 && static_cast<u64>(value) < static_cast<u64>(lo)) ? -1
+         : (static_cast<u64>(value) > static_cast<u64>(hi)) ? +1 : 0;
+  }
+}
+
+// @brief Interval arithmetic on [lo1, hi1] and [lo2, hi2], evaluated at compile time.
+template <i64 lo1, i64 hi1, i64 lo2, i64 hi2> struct interval {
+  static constexpr auto sum_valid = !add_overflows(lo1, lo2) && !add_overflows(hi1, hi2);
+  static constexpr auto sum_lo = sum_valid ? lo1 + lo2 : 0;
+  static constexpr auto sum_hi = sum_valid ? hi1 + hi2 : 0;
+
+  static constexpr auto difference_valid = lo2 != std::numeric_limits<i64>::min()
+                                        && hi2 != std::numeric_limits<i64>::min()
+                                        && !add_overflows(lo1, -hi2) && !add_overflows(hi1, -lo2);
+  static constexpr auto difference_lo = difference_valid ? lo1 - hi2 : 0;
+  static constexpr auto difference_hi = difference_valid ? hi1 - lo2 : 0;
+
+  static constexpr auto product_valid = !mul_overflows(lo1, lo2) && !mul_overflows(lo1, hi2)
+                                     && !mul_overflows(hi1, lo2) && !mul_overflows(hi1, hi2);
+  static constexpr auto product_lo = product_valid ? min_of(min_of(lo1 * lo2, lo1 * hi2),
+                                                            min_of(hi1 * lo2, hi1 * hi2)) : 0;
+  static constexpr auto product_hi = product_valid ? max_of(max_of(lo1 * lo2, lo1 * hi2),
+                                                            max_of(hi1 * lo2, hi1 * hi2)) : 0;
+
+  // truncating division is monotonic in each operand when the divisor does not change sign, so the corners suffice
+  static constexpr auto quotient_valid = (lo2 > 0 || hi2 < 0)
+                                      && !(lo1 == std::numeric_limits<i64>::min() && (lo2 == -1 || hi2 == -1));
+  static constexpr auto quotient_lo = quotient_valid ? min_of(min_of(lo1 / lo2, lo1 / hi2),
+                                                              min_of(hi1 / lo2, hi1 / hi2)) : 0;
+  static constexpr auto quotient_hi = quotient_valid ? max_of(max_of(lo1 / lo2, lo1 / hi2),
+                                                              max_of(hi1 / lo2, hi1 / hi2)) : 0;
+};
+
+}
+
+/// @brief Quantity whose value is known to lie within the closed interval [Lo, Hi].
+///
+/// @remarks The value type is chosen from the range and never needs to be specified. Bounded quantities are only
+///          constructed through \c constant, \c clamp and \c assume, or as the result of arithmetic on other bounded
+///          quantities, so the range is an invariant of the type.
+template <typename Dimension, i64 Lo, i64 Hi> struct bounded_quantity {
+  static_assert(Lo <= Hi, "empty range");
+
+  using dimension = Dimension;
+  using value_type = detail::storage_for_t<Lo, Hi>;
+
+  static constexpr i64 min = Lo;
+  static constexpr i64 max = Hi;
+
+private:
+  template <typename OtherDimension, i64 Lo2, i64 Hi2> friend struct bounded_quantity;
+
+  constexpr explicit bounded_quantity(value_type value) : value(value) {}
+
+  template <typename OtherDimension, i64 Lo2, i64 Hi2, typename T> static constexpr auto make(T value) {
+    using result = bounded_quantity<OtherDimension, Lo2, Hi2>;
+    return result{static_cast<typename result::value_type>(value)};
+  }
+
+  template <i64 Lo2, i64 Hi2> using common_t = detail::storage_for_t<detail::min_of(Lo, Lo2), detail::max_of(Hi, Hi2)>;
+
+public:
+  /// @brief Constructs a bounded quantity with a single value.
+  template <i64 value> static constexpr auto constant() {
+    static_assert(Lo <= value && value <= Hi, "constant out of range");
+    return bounded_quantity{static_cast<value_type>(value)};
+  }
+
+  /// @brief Constructs a bounded quantity from an arbitrary value, saturating it to the range.
+  template <typename T> static constexpr auto clamp(quantity<T, Dimension> q) {
+    auto value = q.template as<Dimension>();
+
+    switch (detail::range_position<Lo, Hi>(value)) {
+      case -1: return bounded_quantity{static_cast<value_type>(Lo)};
+      case +1: return bounded_quantity{static_cast<value_type>(Hi)};
+      default: return bounded_quantity{static_cast<value_type>(value)};
+    }
+  }
+
+  /// @brief Constructs a bounded quantity from a value the caller guarantees to be in range.
+  ///
+  /// @remarks The guarantee is checked by an assert.
+  template <typename T> static constexpr auto assume(quantity<T, Dimension> q) {
+    auto value = q.template as<Dimension>();
+
+    if (detail::range_position<Lo, Hi>(value) != 0) {
+      rtl::assert(false, TRACE("bounded quantity out of range"));
+    }
+
+    return bounded_quantity{static_cast<value_type>(value)};
+  }
+
+  /// @brief Widens the range, which is always safe.
+  template <i64 Lo2, i64 Hi2> constexpr operator bounded_quantity<Dimension, Lo2, Hi2>() const {
+    static_assert(Lo2 <= Lo && Hi <= Hi2, "implicit narrowing of a bounded quantity, use narrow() instead");
+    return make<Dimension, Lo2, Hi2>(value);
+  }
+
+  /// @brief Restricts the range, saturating the value to the new range.
+  template <i64 Lo2, i64 Hi2> constexpr auto narrow() const {
+    static_assert(Lo2 <= Hi2, "empty range");
+    using U = common_t<Lo2, Hi2>;
+
+    if (static_cast<U>(value) < static_cast<U>(Lo2)) {
+      return make<Dimension, Lo2, Hi2>(Lo2);
+    } else if (static_cast<U>(value) > static_cast<U>(Hi2)) {
+      return make<Dimension, Lo2, Hi2>(Hi2);
+    } else {
+      return make<Dimension, Lo2, Hi2>(value);
+    }
+  }
+
+  constexpr auto get() const {
+    return value;
+  }
+
+  template <typename T2, typename OtherDimension> constexpr operator quantity<T2, OtherDimension>() const {
+    return quantity<value_type, Dimension>{value};
+  }
+
+  constexpr auto operator-() const {
+    static_assert(Lo != std::numeric_limits<i64>::min(), "range overflows");
+    using U = detail::storage_for_t<detail::min_of(Lo, -Hi), detail::max_of(Hi, -Lo)>;
+    return make<Dimension, -Hi, -Lo>(-static_cast<U>(value));
+  }
+
+  template <i64 Lo2, i64 Hi2> constexpr auto operator+(bounded_quantity<Dimension, Lo2, Hi2> rhs) const {
+    using range = detail::interval<Lo, Hi, Lo2, Hi2>;
+    static_assert(range::sum_valid, "range overflows");
+
+    using U = detail::storage_for_t<detail::min_of(range::sum_lo, detail::min_of(Lo, Lo2)),
+                                    detail::max_of(range::sum_hi, detail::max_of(Hi, Hi2))>;
+    return make<Dimension, range::sum_lo, range::sum_hi>(static_cast<U>(value) + static_cast<U>(rhs.value));
+  }
+
+  template <i64 Lo2, i64 Hi2> constexpr auto operator-(bounded_quantity<Dimension, Lo2, Hi2> rhs) const {
+    using range = detail::interval<Lo, Hi, Lo2, Hi2>;
+    static_assert(range::difference_valid, "range overflows");
+
+    using U = detail::storage_for_t<detail::min_of(range::difference_lo, detail::min_of(Lo, Lo2)),
+                                    detail::max_of(range::difference_hi, detail::max_of(Hi, Hi2))>;
+    return make<Dimension, range::difference_lo, range::difference_hi>(static_cast<U>(value) - static_cast<U>(rhs.value));
+  }
+
+  template <typename OtherDimension, i64 Lo2, i64 Hi2>
+  constexpr auto operator*(bounded_quantity<OtherDimension, Lo2, Hi2> rhs) const {
+    using range = detail::interval<Lo, Hi, Lo2, Hi2>;
+    static_assert(range::product_valid, "range overflows");
+
+    using U = detail::storage_for_t<detail::min_of(range::product_lo, detail::min_of(Lo, Lo2)),
+                                    detail::max_of(range::product_hi, detail::max_of(Hi, Hi2))>;
+    using product = typename Dimension::template product<OtherDimension>::value;
+    return make<product, range::product_lo, range::product_hi>(static_cast<U>(value) * static_cast<U>(rhs.value));
+  }
+
+  template <typename OtherDimension, i64 Lo2, i64 Hi2>
+  constexpr auto operator/(bounded_quantity<OtherDimension, Lo2, Hi2> rhs) const {
+    using range = detail::interval<Lo, Hi, Lo2, Hi2>;
+    static_assert(range::quotient_valid, "divisor range contains zero or quotient overflows");
+
+    using U = detail::storage_for_t<detail::min_of(range::quotient_lo, detail::min_of(Lo, Lo2)),
+                                    detail::max_of(range::quotient_hi, detail::max_of(Hi, Hi2))>;
+    using quotient = typename Dimension::template quotient<OtherDimension>::value;
+    return make<quotient, range::quotient_lo, range::quotient_hi>(static_cast<U>(value) / static_cast<U>(rhs.value));
+  }
+
+  template <i64 Lo2, i64 Hi2> constexpr auto operator==(bounded_quantity<Dimension, Lo2, Hi2> rhs) const {
+    using U = common_t<Lo2, Hi2>;
+    return static_cast<U>(value) == static_cast<U>(rhs.value);
+  }
+
+  template <i64 Lo2, i64 Hi2> constexpr auto operator<(bounded_quantity<Dimension, Lo2, Hi2> rhs) const {
+    using U = common_t<Lo2, Hi2>;
+    return static_cast<U>(value) < static_cast<U>(rhs.value);
+  }
+
+  template <i64 Lo2, i64 Hi2> constexpr auto operator!=(bounded_quantity<Dimension, Lo2, Hi2> rhs) const { return !(*this == rhs); }
+  template <i64 Lo2, i64 Hi2> constexpr auto operator>(bounded_quantity<Dimension, Lo2, Hi2> rhs)  const { return rhs < *this; }
+  template <i64 Lo2, i64 Hi2> constexpr auto operator<=(bounded_quantity<Dimension, Lo2, Hi2> rhs) const { return !(*this > rhs); }
+  template <i64 Lo2, i64 Hi2> constexpr auto operator>=(bounded_quantity<Dimension, Lo2, Hi2> rhs) const { return !(*this < rhs); }
+
+private:
+  value_type value;
+};
+
+/// @brief Dimensionless bounded constant, for scaling bounded quantities.
+template <i64 value> constexpr auto bounded_constant = bounded_quantity<dimensionless, value, value>::template constant<value>();
+
+}
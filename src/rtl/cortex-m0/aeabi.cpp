@@ -0,0 +1,61 @@
+#include <rtl/platform.hpp>
+#include <rtl/math/divide.hpp>
+
+// Integer arithmetic routines of the ARM run-time ABI, replacing the generic libgcc implementations. The 32-bit
+// division entry points are weak so that the HAL can substitute a faster divider where the part has one, while the
+// 64-bit division entry points are assembly shims in aeabi.S which return their remainder in r2:r3.
+//
+// Defining RTL_LIBGCC_ARITHMETIC (and leaving out aeabi.S) omits all of them, so that the firmware falls back to libgcc
+// for benchmarking.
+
+#if !defined(RTL_LIBGCC_ARITHMETIC)
+
+#define weak __attribute__((weak))
+
+namespace {
+
+// the quotient is returned in r0 and the remainder in r1
+constexpr auto pack(rtl::u32 quotient, rtl::u32 remainder) {
+  return (static_cast<rtl::u64>(remainder) << 32) | quotient;
+}
+
+}
+
+extern "C" weak rtl::u32 __aeabi_uidiv(rtl::u32 n, rtl::u32 d) {
+  return rtl::divmod(n, d).quotient;
+}
+
+extern "C" weak rtl::u64 __aeabi_uidivmod(rtl::u32 n, rtl::u32 d) {
+  auto result = rtl::divmod(n, d);
+  return pack(result.quotient, result.remainder);
+}
+
+extern "C" weak rtl::i32 __aeabi_idiv(rtl::i32 n, rtl::i32 d) {
+  return rtl::divmod(n, d).quotient;
+}
+
+extern "C" weak rtl::u64 __aeabi_idivmod(rtl::i32 n, rtl::i32 d) {
+  auto result = rtl::divmod(n, d);
+  return pack(static_cast<rtl::u32>(result.quotient), static_cast<rtl::u32>(result.remainder));
+}
+
+extern "C" rtl::u64 __aeabi_lmul(rtl::u64 a, rtl::u64 b) {
+  return rtl::multiply(a, b);
+}
+
+// called by __aeabi_uldivmod and __aeabi_ldivmod
+extern "C" rtl::u64 rtl_uldivmod(rtl::u64 n, rtl::u64 d, rtl::u64* remainder) {
+  auto result = rtl::divmod(n, d);
+  *remainder = result.remainder;
+  return result.quotient;
+}
+
+extern "C" rtl::i64 rtl_ldivmod(rtl::i64 n, rtl::i64 d, rtl::i64* remainder) {
+  auto result = rtl::divmod(n, d);
+  *remainder = result.remainder;
+  return result.quotient;
+}
+
+#undef weak
+
+#endif
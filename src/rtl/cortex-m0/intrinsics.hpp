@@ -4,22 +4,56 @@
 ///
 /// @brief Intrinsics for the Cortex-M0 processor.
 
+#include <rtl/base.hpp>
+
 namespace rtl::intrinsics {
 
+namespace detail {
+
+static constexpr rtl::u8 debruijn_ctz_table[32] = {
+   0,  1, 28,  2, 29, 14, 24,  3, 30, 22, 20, 15, 25, 17,  4,  8,
+  31, 27, 13, 23, 21, 19, 16,  7, 26, 12, 18,  6, 11,  5, 10,  9
+};
+
+}
+
+/// @brief Counts the trailing zero bits of a nonzero integer.
+///
+/// @remarks ARMv6-M has no CLZ or RBIT instruction, so the lowest set bit is isolated and looked up through a de Bruijn
+///          sequence, which costs a single multiplication.
+constexpr std::size_t count_trailing_zeros(rtl::u32 x) {
+  return detail::debruijn_ctz_table[((x & (0u - x)) * 0x077CB531u) >> 27];
+}
+
+/// @brief Counts the trailing zero bits of a nonzero integer.
+constexpr std::size_t count_trailing_zeros(rtl::u64 x) {
+  auto lo = static_cast<rtl::u32>(x);
+  return (lo != 0) ? count_trailing_zeros(lo) : 32 + count_trailing_zeros(static_cast<rtl::u32>(x >> 32));
+}
+
 /// @brief Enables interrupt handling.
 inline auto enable_interrupts() {
-  asm volatile ("cpsie i");
+  asm volatile ("cpsie i" : : : "memory");
 }
 
 /// @brief Disables interrupt handling.
 inline auto disable_interrupts() {
-  asm volatile ("cpsid i");
+  asm volatile ("cpsid i" : : : "memory");
 }
 
+/// @brief Runs the given function with interrupts disabled.
+///
+/// @remarks Interrupts are only enabled again if they were enabled on entry, so these sections nest.
 template <typename T> auto non_preemptible(T context) {
+  rtl::u32 primask;
+  asm volatile ("mrs %0, primask" : "=r" (primask) : : "memory");
+
   disable_interrupts();
   context();
-  enable_interrupts();
+
+  if ((primask & 1) == 0) {
+    enable_interrupts();
+  }
 }
 
 /// @brief Pauses execution until after at least one interrupt has been handled.
@@ -27,6 +61,14 @@ inline auto wait_for_interrupt() {
   asm volatile ("wfi");
 }
 
+/// @brief Prevents the compiler from moving memory accesses across this point.
+///
+/// @remarks The Cortex-M0 has a single core and does not reorder its own memory accesses, so this suffices to order
+///          accesses between thread mode and interrupt handlers.
+inline auto compiler_barrier() {
+  asm volatile ("" : : : "memory");
+}
+
 /// @brief Returns whether the current execution context is privileged.
 inline auto privileged() {
   return true;
@@ -0,0 +1,235 @@
+#pragma once
+
+/// @file
+///
+/// @brief Integer division for the Cortex-M0 processor.
+///
+/// ARMv6-M has no divide instruction. These kernels implement the division routines of the ARM run-time ABI; they only
+/// use 32-bit multiplications, shifts and subtractions, and exit early whenever the quotient is known to be small, the
+/// divisor is a power of two or the operands fit in narrower types. Divisions by compile-time constants should use
+/// \c rtl::divide, which never divides at runtime.
+
+#include <rtl/base.hpp>
+#include <rtl/intrinsics.hpp>
+#include <rtl/math/multiply.hpp>
+
+namespace rtl {
+
+template <typename T> struct division_result {
+  T quotient;
+  T remainder;
+};
+
+namespace detail {
+
+// @brief Shift-and-subtract division of a dividend by a smaller nonzero divisor.
+//
+// @remarks The divisor is first aligned with the dividend four bits at a time, so the number of iterations is the
+//          number of quotient bits rather than the width of the type.
+template <typename T> constexpr auto shift_subtract(T n, T d) {
+  constexpr auto top = T{1} << (sizeof(T) * 8 - 1);
+  constexpr auto top_nibble = T{0xF} << (sizeof(T) * 8 - 4);
+
+  auto bit = T{1};
+
+  while (!(d & top_nibble) && (d << 4) <= n) {
+    d <<= 4;
+    bit <<= 4;
+  }
+
+  while (!(d & top) && (d << 1) <= n) {
+    d <<= 1;
+    bit <<= 1;
+  }
+
+  auto quotient = T{0};
+
+  while (bit != 0) {
+    if (n >= d) {
+      n -= d;
+      quotient |= bit;
+    }
+
+    d >>= 1;
+    bit >>= 1;
+  }
+
+  return division_result<T>{quotient, n};
+}
+
+// @brief Divides a 64-bit dividend by a 32-bit divisor whose quotient fits in 32 bits, i.e. hi < d.
+constexpr auto divide_wide(u32 hi, u32 lo, u32 d) {
+  auto quotient = u32{0};
+
+  for (auto i = 0; i < 32; ++i) {
+    auto carry = hi >> 31;
+    hi = (hi << 1) | (lo >> 31);
+    lo <<= 1;
+    quotient <<= 1;
+
+    if (carry || hi >= d) {
+      hi -= d;
+      quotient |= 1;
+    }
+  }
+
+  return division_result<u32>{quotient, hi};
+}
+
+struct reciprocal_parameters {
+  u32 multiplier;
+  std::size_t shift;
+  bool exact;
+};
+
+// @brief Computes a reciprocal multiplier approximating multiplication by num / den < 1 for 32-bit magnitudes.
+//
+// With M = ceil(num * 2^K / den) for K = 32 + shift and e = M * den - num * 2^K, (x * M) >> K is equal to
+// floor(x * num / den) whenever x * e < 2^K, which holds for every 32-bit x if e <= 2^shift. Otherwise, as K >= 32,
+// the result exceeds floor(x * num / den) by at most one.
+constexpr auto reciprocal_of(u64 num, u64 den) {
+  auto remainder = num;
+  auto shift = std::size_t{0};
+
+  while (remainder * 2 < den) {
+    remainder *= 2;
+    ++shift;
+  }
+
+  auto multiplier = u64{0};
+
+  for (auto bit = 0; bit < 32; ++bit) {
+    remainder *= 2;
+    multiplier *= 2;
+
+    if (remainder >= den) {
+      remainder -= den;
+      multiplier += 1;
+    }
+  }
+
+  auto error = u64{0};
+
+  if (remainder != 0) {
+    multiplier += 1;
+    error = den - remainder;
+  }
+
+  return reciprocal_parameters{static_cast<u32>(multiplier), shift,
+                               multiplier <= std::numeric_limits<u32>::max() && (shift >= 64 || error <= (u64{1} << shift))};
+}
+
+}
+
+/// @brief Divides two unsigned 32-bit integers.
+///
+/// @remarks Division by zero returns a zero quotient and the dividend as remainder.
+constexpr auto divmod(u32 n, u32 d) {
+  if (d > n || d == 0) {
+    return division_result<u32>{0, n};
+  }
+
+  if ((d & (d - 1)) == 0) {
+    auto shift = rtl::intrinsics::count_trailing_zeros(d);
+    return division_result<u32>{n >> shift, n & (d - 1)};
+  }
+
+  return detail::shift_subtract(n, d);
+}
+
+/// @brief Divides two unsigned 64-bit integers.
+///
+/// @remarks Division by zero returns a zero quotient and the dividend as remainder.
+constexpr auto divmod(u64 n, u64 d) {
+  auto n_hi = static_cast<u32>(n >> 32), n_lo = static_cast<u32>(n);
+  auto d_hi = static_cast<u32>(d >> 32), d_lo = static_cast<u32>(d);
+
+  if (d > n || d == 0) {
+    return division_result<u64>{0, n};
+  }
+
+  if (n_hi == 0) {
+    auto result = divmod(n_lo, d_lo);
+    return division_result<u64>{result.quotient, result.remainder};
+  }
+
+  if (d_hi == 0) {
+    if ((d_lo & (d_lo - 1)) == 0) {
+      auto shift = rtl::intrinsics::count_trailing_zeros(d_lo);
+      return division_result<u64>{n >> shift, n & (d - 1)};
+    }
+
+    // two-step long division, the high word first, leaving a remainder smaller than the divisor
+    auto high = divmod(n_hi, d_lo);
+
+    if (d_lo <= 0xFFFF) {
+      // 16-bit digits keep every partial dividend within 32 bits
+      auto mid = divmod((high.remainder << 16) | (n_lo >> 16), d_lo);
+      auto low = divmod((mid.remainder << 16) | (n_lo & 0xFFFF), d_lo);
+
+      return division_result<u64>{(static_cast<u64>(high.quotient) << 32) | (mid.quotient << 16) | low.quotient,
+                                  low.remainder};
+    }
+
+    auto low = detail::divide_wide(high.remainder, n_lo, d_lo);
+    return division_result<u64>{(static_cast<u64>(high.quotient) << 32) | low.quotient, low.remainder};
+  }
+
+  // the divisor has a nonzero high word, so the quotient has at most 32 bits
+  return detail::shift_subtract(n, d);
+}
+
+/// @brief Divides two signed 32-bit integers, rounding the quotient towards zero.
+constexpr auto divmod(i32 n, i32 d) {
+  auto n_magnitude = (n < 0) ? u32{0} - static_cast<u32>(n) : static_cast<u32>(n);
+  auto d_magnitude = (d < 0) ? u32{0} - static_cast<u32>(d) : static_cast<u32>(d);
+
+  auto result = divmod(n_magnitude, d_magnitude);
+  auto quotient = ((n < 0) != (d < 0)) ? u32{0} - result.quotient : result.quotient;
+  auto remainder = (n < 0) ? u32{0} - result.remainder : result.remainder;
+
+  return division_result<i32>{static_cast<i32>(quotient), static_cast<i32>(remainder)};
+}
+
+/// @brief Divides two signed 64-bit integers, rounding the quotient towards zero.
+constexpr auto divmod(i64 n, i64 d) {
+  auto n_magnitude = (n < 0) ? u64{0} - static_cast<u64>(n) : static_cast<u64>(n);
+  auto d_magnitude = (d < 0) ? u64{0} - static_cast<u64>(d) : static_cast<u64>(d);
+
+  auto result = divmod(n_magnitude, d_magnitude);
+  auto quotient = ((n < 0) != (d < 0)) ? u64{0} - result.quotient : result.quotient;
+  auto remainder = (n < 0) ? u64{0} - result.remainder : result.remainder;
+
+  return division_result<i64>{static_cast<i64>(quotient), static_cast<i64>(remainder)};
+}
+
+/// @brief Multiplies two 64-bit integers, keeping the low 64 bits of the product.
+constexpr auto multiply(u64 a, u64 b) {
+  auto a_lo = static_cast<u32>(a), a_hi = static_cast<u32>(a >> 32);
+  auto b_lo = static_cast<u32>(b), b_hi = static_cast<u32>(b >> 32);
+
+  return umull(a_lo, b_lo) + (static_cast<u64>(a_lo * b_hi + a_hi * b_lo) << 32);
+}
+
+/// @brief Divides an unsigned 32-bit integer by a compile-time constant.
+///
+/// @remarks This multiplies by a precomputed reciprocal and corrects the estimate with a single multiplication, so it
+///          is exact for every dividend and never divides at runtime.
+template <u32 d> constexpr u32 divide(u32 n) {
+  static_assert(d != 0, "division by zero");
+
+  if constexpr ((d & (d - 1)) == 0) {
+    return n >> rtl::intrinsics::count_trailing_zeros(d);
+  } else if constexpr (d > 0x80000000u) {
+    return (n >= d) ? 1 : 0;
+  } else {
+    constexpr auto reciprocal = detail::reciprocal_of(1, d);
+    static_assert(reciprocal.multiplier != 0, "unsupported divisor");
+
+    // the estimate is either exact or one too large, in which case the remainder wraps around past the divisor
+    auto quotient = umulh(n, reciprocal.multiplier) >> reciprocal.shift;
+    return (n - quotient * d >= d) ? quotient - 1 : quotient;
+  }
+}
+
+}
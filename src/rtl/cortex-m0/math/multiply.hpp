@@ -0,0 +1,56 @@
+#pragma once
+
+/// @file
+///
+/// @brief Widening multiplication for the Cortex-M0 processor.
+///
+/// ARMv6-M only has a 32x32->32 \c MULS instruction, and compilers lower every 64-bit product to a call to the generic
+/// 64x64 \c __aeabi_lmul routine. These kernels compute 32x32->64 products from four 16x16 partial products instead.
+
+#include <rtl/base.hpp>
+
+namespace rtl {
+
+namespace detail {
+
+struct wide_product {
+  u32 hi;
+  u32 lo;
+};
+
+constexpr wide_product umull_parts(u32 a, u32 b) {
+  auto a_lo = a & 0xFFFF, a_hi = a >> 16;
+  auto b_lo = b & 0xFFFF, b_hi = b >> 16;
+
+  auto lo = a_lo * b_lo;
+  auto mid_a = a_hi * b_lo + (lo >> 16);           // cannot overflow
+  auto mid_b = a_lo * b_hi + (mid_a & 0xFFFF);     // cannot overflow
+
+  return wide_product{a_hi * b_hi + (mid_a >> 16) + (mid_b >> 16), (mid_b << 16) | (lo & 0xFFFF)};
+}
+
+}
+
+/// @brief Computes the full 64-bit product of two unsigned 32-bit integers.
+constexpr u64 umull(u32 a, u32 b) {
+  auto product = detail::umull_parts(a, b);
+  return (static_cast<u64>(product.hi) << 32) | product.lo;
+}
+
+/// @brief Computes the high 32 bits of the product of two unsigned 32-bit integers.
+constexpr u32 umulh(u32 a, u32 b) {
+  return detail::umull_parts(a, b).hi;
+}
+
+/// @brief Computes the full 64-bit product of two signed 32-bit integers.
+///
+/// @remarks The unsigned product of the two's complement representations is corrected by subtracting each operand from
+///          the high word when the other one is negative.
+constexpr i64 smull(i32 a, i32 b) {
+  auto product = detail::umull_parts(static_cast<u32>(a), static_cast<u32>(b));
+  auto hi = product.hi - ((a < 0) ? static_cast<u32>(b) : 0) - ((b < 0) ? static_cast<u32>(a) : 0);
+
+  return static_cast<i64>((static_cast<u64>(hi) << 32) | product.lo);
+}
+
+}
@@ -5,11 +5,16 @@
 /// @brief Rational arithmetic for the Cortex-M0 processor.
 
 #include <rtl/base.hpp>
+#include <rtl/assert.hpp>
+#include <rtl/intrinsics.hpp>
 
 namespace rtl {
 
-// TODO: rational mode should be a template on the operators, not the class itself
-
+/// @brief Normalization policy applied when evaluating a rational expression.
+///
+/// Both policies give exact results whenever the unreduced result of every operator fits the rational type. When it
+/// does not, \c best first reduces the fraction to lowest terms and only then truncates it, so it stays exact whenever
+/// the reduced result fits, while \c fast truncates it directly, which is cheaper but can lose precision.
 enum class rational_mode {
   best,
   fast
@@ -94,6 +99,10 @@ public:
   using S = typename std::make_signed<U>::type;
   using SD = typename std::make_signed<UD>::type;
 
+  /// @brief Returns the numerator and denominator of the fraction.
+  ///
+  /// @remarks Results evaluated under the \c best policy are in lowest terms. Results evaluated under the \c fast
+  ///          policy are only reduced by the truncation of results which do not fit, so they may share a factor.
   constexpr auto numerator() const { return p; }
   constexpr auto denominator() const { return q; }
 
@@ -118,8 +127,8 @@ public:
   }
 
   constexpr rational(S p, U q) : p(p), q(q) {
-    if (q != 0) {
-      rtl::assert(q != 0, "denominator must be nonzero");
+    if (q == 0) {
+      rtl::assert(false, "denominator must be nonzero");
     }
   }
 
@@ -150,212 +159,92 @@ public:
   }
 
   constexpr auto& operator+=(rational<U, UD, mode> rhs) {
-    auto pd = static_cast<SD>(this->p) * static_cast<SD>(rhs.q)
-            + static_cast<SD>(this->q) * static_cast<SD>(rhs.p);
-    auto qd = static_cast<UD>(this->q) * static_cast<UD>(rhs.q);
-
-    normalize(pd, qd);
-
-    this->p = static_cast<S>(pd);
-    this->q = static_cast<U>(qd);
-
-    return *this;
-  }
-
-  constexpr auto& operator+=(S rhs) {
-    auto pd = static_cast<SD>(this->p)
-            + static_cast<SD>(this->q) * static_cast<SD>(rhs);
-    auto qd = static_cast<UD>(this->q);
-
-    normalize(pd, qd);
-
-    this->p = static_cast<S>(pd);
-    this->q = static_cast<U>(qd);
-
-    return *this;
-  }
-
-  constexpr auto operator+(rational<U, UD, mode> rhs) const {
-    auto lhs = *this;
-    return lhs += rhs;
+    return *this = *this + rhs;
   }
 
   constexpr auto& operator-=(rational<U, UD, mode> rhs) {
-    auto pd = static_cast<SD>(this->p) * static_cast<SD>(rhs.q)
-            - static_cast<SD>(this->q) * static_cast<SD>(rhs.p);
-    auto qd = static_cast<UD>(this->q) * static_cast<UD>(rhs.q);
-
-    normalize(pd, qd);
-
-    this->p = static_cast<S>(pd);
-    this->q = static_cast<U>(qd);
-
-    return *this;
-  }
-
-  constexpr auto& operator-=(S rhs) {
-    auto pd = static_cast<SD>(this->p)
-            - static_cast<SD>(this->q) * static_cast<SD>(rhs);
-    auto qd = static_cast<UD>(this->q);
-
-    normalize(pd, qd);
-
-    this->p = static_cast<S>(pd);
-    this->q = static_cast<U>(qd);
-
-    return *this;
-  }
-
-  constexpr auto operator-(rational<U, UD, mode> rhs) const {
-    auto lhs = *this;
-    return lhs -= rhs;
+    return *this = *this - rhs;
   }
 
   constexpr auto& operator*=(rational<U, UD, mode> rhs) {
-    auto pd = static_cast<SD>(this->p) * static_cast<SD>(rhs.p);
-    auto qd = static_cast<UD>(this->q) * static_cast<UD>(rhs.q);
-
-    normalize(pd, qd);
-
-    this->p = static_cast<S>(pd);
-    this->q = static_cast<U>(qd);
-
-    return *this;
-  }
-
-  constexpr auto& operator*=(S rhs) {
-    auto pd = static_cast<SD>(this->p) * static_cast<SD>(rhs);
-    auto qd = static_cast<UD>(this->q);
-
-    normalize(pd, qd);
-
-    this->p = static_cast<S>(pd);
-    this->q = static_cast<U>(qd);
-
-    return *this;
-  }
-
-  constexpr auto operator*(rational<U, UD, mode> rhs) const {
-    auto lhs = *this;
-    return lhs *= rhs;
+    return *this = *this * rhs;
   }
 
   constexpr auto& operator/=(rational<U, UD, mode> rhs) {
-    auto pd = static_cast<SD>(this->p) * static_cast<SD>(rhs.q);
-    auto qd = static_cast<UD>(this->q) * static_cast<UD>(rhs.p);
-
-    normalize(pd, qd);
-
-    this->p = static_cast<S>(pd);
-    this->q = static_cast<U>(qd);
-
-    return *this;
+    return *this = *this / rhs;
   }
 
-  constexpr auto& operator/=(S rhs) {
-    auto pd = static_cast<SD>(this->p);
-    auto qd = static_cast<UD>(this->q) * static_cast<SD>(rhs);
+  static constexpr auto default_mode = mode;
 
-    normalize(pd, qd);
+private:
+  template <typename Rational> friend struct rational_arithmetic;
 
-    this->p = static_cast<S>(pd);
-    this->q = static_cast<U>(qd);
+  // @brief Computes the greatest common divisor of two nonzero integers, at least one of which is odd.
+  //
+  // @remarks This is Stein's binary algorithm, which only needs shifts and subtractions; the Euclidean algorithm would
+  //          need a double-width software division at every step.
+  constexpr static auto gcd(UD a, UD b) {
+    a >>= rtl::intrinsics::count_trailing_zeros(a);
 
-    return *this;
-  }
+    while (true) {
+      b >>= rtl::intrinsics::count_trailing_zeros(b);
 
-  constexpr auto operator/(rational<U, UD, mode> rhs) const {
-    auto lhs = *this;
-    return lhs /= rhs;
-  }
+      if (a > b) {
+        auto t = a;
+        a = b;
+        b = t;
+      }
 
-  constexpr auto operator==(rational<U, UD, mode> rhs) const {
-    auto lhs_d = static_cast<SD>(this->p) * static_cast<SD>(rhs.q);
-    auto rhs_d = static_cast<SD>(rhs.p) * static_cast<SD>(this->q);
+      b -= a;
 
-    return lhs_d == rhs_d;
+      if (b == 0) {
+        return a;
+      }
+    }
   }
 
-  constexpr auto operator!=(rational<U, UD, mode> rhs) const {
-    return !(*this == rhs);
+  constexpr static auto fits(UD magnitude, UD qd) {
+    return magnitude <= static_cast<UD>(std::numeric_limits<S>::max()) && qd <= std::numeric_limits<U>::max();
   }
-  
-  constexpr auto operator<(rational<U, UD, mode> rhs) const {
-    auto lhs_d = static_cast<SD>(this->p) * static_cast<SD>(rhs.q);
-    auto rhs_d = static_cast<SD>(this->q) * static_cast<SD>(rhs.p);
 
-    return lhs_d < rhs_d;
-  }
+  // @brief Reduces a nonzero fraction to lowest terms.
+  constexpr static auto reduce(UD& magnitude, UD& qd) {
+    auto twos = rtl::intrinsics::count_trailing_zeros(magnitude | qd);
+    magnitude >>= twos;
+    qd >>= twos;
 
-  constexpr auto operator>(rational<U, UD, mode> rhs) const {
-    return rhs < *this;
-  }
-  
-  constexpr auto operator<=(rational<U, UD, mode> rhs) const {
-    return !(*this > rhs);
-  }
-  
-  constexpr auto operator>=(rational<U, UD, mode> rhs) const {
-    return !(*this < rhs);
-  }
+    // the divisor is odd and divides both exactly, so multiplying by its inverse modulo 2^N divides exactly
+    auto inv = modinv<UD>(gcd(magnitude, qd));
 
-private:
-  constexpr static auto gcd(UD a, UD b) {
-    auto gcd = UD{1};
-
-    while (b != 0) {
-      gcd = b;
-      b = a % b;
-      a = gcd;
+    if (inv > 1) {
+      magnitude *= inv;
+      qd *= inv;
     }
-
-    return gcd;
   }
 
-  constexpr static auto normalize(SD& pd, UD& qd) {
+  // @brief Truncates a double-width fraction until it fits the narrow type, first reducing it under the \c best policy.
+  //
+  // @remarks An unreduced fraction which fits is still exact, so intermediate results skip the reduction when they
+  //          fit; \c canonical results, which are stored, are always reduced under the \c best policy.
+  template <rational_mode policy, bool canonical = false> constexpr static auto normalize(SD& pd, UD& qd) {
     if (pd == 0) {
       qd = 1;
       return;
     }
 
-    auto positive = true;
-
-    if (pd < 0) {
-      positive = false;
-      pd *= -1;
-    }
-
-    if (mode == rtl::rational_mode::best) {
-      while ((pd % 2 == 0) && (qd % 2 == 0)) {
-        pd /= 2;
-        qd /= 2;
-      }
-  
-      auto inv = modinv<UD>(gcd(pd, qd));
-      //auto divisor = gcd(pd, qd);
-
-      if (inv > 1) {
-        pd *= inv;
-        qd *= inv;
-      }
+    auto positive = pd > 0;
+    auto magnitude = positive ? static_cast<UD>(pd) : UD{0} - static_cast<UD>(pd);
 
-      /*
-      if (divisor > 1) {
-        pd /= divisor;
-        qd /= divisor;
-      }
-      */
+    if (policy == rtl::rational_mode::best && qd != 0 && (canonical || !fits(magnitude, qd))) {
+      reduce(magnitude, qd);
     }
 
-    //while ((pd | qd) & ~std::numeric_limits<U>::max()) {
-    while (pd > std::numeric_limits<S>::max() || qd > std::numeric_limits<U>::max()) {
-      pd /= 2;
-      qd /= 2;
+    while (!fits(magnitude, qd)) {
+      magnitude >>= 1;
+      qd >>= 1;
     }
 
-    if (!positive) {
-      pd *= -1;
-    }
+    pd = positive ? static_cast<SD>(magnitude) : -static_cast<SD>(magnitude);
 
     if (qd == 0) {
       qd = 1;
@@ -398,8 +287,216 @@ private:
   U q{1};
 };
 
+enum class rational_operator {
+  add,
+  subtract,
+  multiply,
+  divide
+};
+
+template <rational_operator op, typename L, typename R> struct rational_expression;
+
+template <typename T> struct rational_traits {
+  static constexpr auto operand = false;
+};
+
+template <typename U, typename UD, rational_mode mode> struct rational_traits<rational<U, UD, mode>> {
+  static constexpr auto operand = true;
+  using type = rational<U, UD, mode>;
+};
+
+template <rational_operator op, typename L, typename R> struct rational_traits<rational_expression<op, L, R>> {
+  static constexpr auto operand = true;
+  using type = typename rational_traits<L>::type;
+};
+
+template <typename T> constexpr auto is_rational_operand = rational_traits<T>::operand;
+
+// @brief Unnormalized double-width fraction, as produced by a single rational operator.
+template <typename Rational> struct wide_rational {
+  typename Rational::SD p;
+  std::make_unsigned_t<typename Rational::SD> q;
+};
+
+template <typename Rational> struct rational_arithmetic {
+  using S = typename Rational::S;
+  using U = decltype(Rational{}.denominator());
+  using SD = typename Rational::SD;
+  using UD = std::make_unsigned_t<SD>;
+
+  template <rational_mode policy> static constexpr auto narrow(wide_rational<Rational> value) {
+    Rational::template normalize<policy>(value.p, value.q);
+    return value;
+  }
+
+  template <rational_mode policy> static constexpr auto finish(wide_rational<Rational> value) {
+    Rational::template normalize<policy, true>(value.p, value.q);
+    return Rational{static_cast<S>(value.p), static_cast<U>(value.q)};
+  }
+
+  template <rational_operator op> static constexpr auto combine(wide_rational<Rational> lhs,
+                                                                wide_rational<Rational> rhs) {
+    switch (op) {
+      case rational_operator::add:
+        return wide_rational<Rational>{lhs.p * static_cast<SD>(rhs.q) + static_cast<SD>(lhs.q) * rhs.p, lhs.q * rhs.q};
+      case rational_operator::subtract:
+        return wide_rational<Rational>{lhs.p * static_cast<SD>(rhs.q) - static_cast<SD>(lhs.q) * rhs.p, lhs.q * rhs.q};
+      case rational_operator::multiply:
+        return wide_rational<Rational>{lhs.p * rhs.p, lhs.q * rhs.q};
+      default:
+        // the sign of the divisor moves to the numerator, as denominators are unsigned
+        if (rhs.p < 0) {
+          return wide_rational<Rational>{-lhs.p * static_cast<SD>(rhs.q), lhs.q * static_cast<UD>(-rhs.p)};
+        } else {
+          return wide_rational<Rational>{lhs.p * static_cast<SD>(rhs.q), lhs.q * static_cast<UD>(rhs.p)};
+        }
+    }
+  }
+};
+
+// @brief Evaluates an operand into a double-width fraction whose parts fit the narrow type.
+template <rational_mode policy, typename Rational, typename T> constexpr auto evaluate_narrow(T operand) {
+  if constexpr (std::is_same<T, Rational>::value) {
+    using SD = typename Rational::SD;
+    using UD = std::make_unsigned_t<SD>;
+    return wide_rational<Rational>{static_cast<SD>(operand.numerator()), static_cast<UD>(operand.denominator())};
+  } else {
+    return rational_arithmetic<Rational>::template narrow<policy>(operand.template evaluate_wide<policy>());
+  }
 }
 
+/// @brief Lazily evaluated tree of rational operators.
+///
+/// Operands are held by value, so expressions may safely outlive the rationals they were built from. Every operator
+/// computes its exact double-width result from narrow operands, and a subexpression is only normalized when its
+/// result does not fit the narrow type, so a whole expression normalizes once unless its intermediates overflow. Under
+/// the \c best policy, that final normalization also reduces the result to lowest terms.
+template <rational_operator op, typename L, typename R> struct rational_expression {
+  using rational_type = typename rational_traits<L>::type;
+
+  L lhs;
+  R rhs;
+
+  template <rational_mode policy> constexpr auto evaluate_wide() const {
+    return rational_arithmetic<rational_type>::template combine<op>(evaluate_narrow<policy, rational_type>(lhs),
+                                                                    evaluate_narrow<policy, rational_type>(rhs));
+  }
+
+  template <rational_mode policy> constexpr auto evaluate() const {
+    return rational_arithmetic<rational_type>::template finish<policy>(evaluate_wide<policy>());
+  }
+
+  /// @brief Evaluates the expression using the default mode of its rational type.
+  constexpr operator rational_type() const {
+    return evaluate<rational_type::default_mode>();
+  }
+
+  template <typename U2, typename UD2, rational_mode mode2> constexpr operator rational<U2, UD2, mode2>() const {
+    return rational<U2, UD2, mode2>{evaluate<rational_type::default_mode>()};
+  }
+};
+
+template <typename L, typename R> using rational_operand_t
+  = typename rational_traits<std::conditional_t<is_rational_operand<L>, L, R>>::type;
+
+template <typename Rational, typename T> constexpr auto as_operand(T x) {
+  if constexpr (!is_rational_operand<T>) {
+    if constexpr (std::is_integral<T>::value) {
+      return Rational{static_cast<typename Rational::S>(x)};
+    } else {
+      return Rational{x};
+    }
+  } else if constexpr (std::is_same<typename rational_traits<T>::type, Rational>::value) {
+    return x;
+  } else {
+    return Rational{static_cast<typename rational_traits<T>::type>(x)};
+  }
+}
+
+template <rational_mode policy, typename T> constexpr auto evaluate(T operand) {
+  if constexpr (std::is_same<T, typename rational_traits<T>::type>::value) {
+    return operand;
+  } else {
+    return operand.template evaluate<policy>();
+  }
+}
+
+template <rational_operator op, typename L, typename R> constexpr auto make_expression(L lhs, R rhs) {
+  using Rational = rational_operand_t<L, R>;
+
+  auto lhs_operand = as_operand<Rational>(lhs);
+  auto rhs_operand = as_operand<Rational>(rhs);
+
+  return rational_expression<op, decltype(lhs_operand), decltype(rhs_operand)>{lhs_operand, rhs_operand};
+}
+
+template <typename L, typename R> constexpr auto rational_compare(L lhs, R rhs) {
+  using Rational = rational_operand_t<L, R>;
+  using SD = typename Rational::SD;
+
+  auto lhs_value = evaluate<Rational::default_mode>(as_operand<Rational>(lhs));
+  auto rhs_value = evaluate<Rational::default_mode>(as_operand<Rational>(rhs));
+
+  auto lhs_d = static_cast<SD>(lhs_value.numerator()) * static_cast<SD>(rhs_value.denominator());
+  auto rhs_d = static_cast<SD>(rhs_value.numerator()) * static_cast<SD>(lhs_value.denominator());
+
+  return (lhs_d > rhs_d) - (lhs_d < rhs_d);
+}
+
+template <typename L, typename R> constexpr auto any_rational_operand = is_rational_operand<L> || is_rational_operand<R>;
+
+template <typename L, typename R, typename = std::enable_if_t<any_rational_operand<L, R>>>
+constexpr auto operator+(L lhs, R rhs) {
+  return make_expression<rational_operator::add>(lhs, rhs);
+}
+
+template <typename L, typename R, typename = std::enable_if_t<any_rational_operand<L, R>>>
+constexpr auto operator-(L lhs, R rhs) {
+  return make_expression<rational_operator::subtract>(lhs, rhs);
+}
+
+template <typename L, typename R, typename = std::enable_if_t<any_rational_operand<L, R>>>
+constexpr auto operator*(L lhs, R rhs) {
+  return make_expression<rational_operator::multiply>(lhs, rhs);
+}
+
+template <typename L, typename R, typename = std::enable_if_t<any_rational_operand<L, R>>>
+constexpr auto operator/(L lhs, R rhs) {
+  return make_expression<rational_operator::divide>(lhs, rhs);
+}
+
+template <typename L, typename R, typename = std::enable_if_t<any_rational_operand<L, R>>>
+constexpr auto operator==(L lhs, R rhs) { return rational_compare(lhs, rhs) == 0; }
+
+template <typename L, typename R, typename = std::enable_if_t<any_rational_operand<L, R>>>
+constexpr auto operator!=(L lhs, R rhs) { return rational_compare(lhs, rhs) != 0; }
+
+template <typename L, typename R, typename = std::enable_if_t<any_rational_operand<L, R>>>
+constexpr auto operator<(L lhs, R rhs)  { return rational_compare(lhs, rhs) < 0; }
+
+template <typename L, typename R, typename = std::enable_if_t<any_rational_operand<L, R>>>
+constexpr auto operator>(L lhs, R rhs)  { return rational_compare(lhs, rhs) > 0; }
+
+template <typename L, typename R, typename = std::enable_if_t<any_rational_operand<L, R>>>
+constexpr auto operator<=(L lhs, R rhs) { return rational_compare(lhs, rhs) <= 0; }
+
+template <typename L, typename R, typename = std::enable_if_t<any_rational_operand<L, R>>>
+constexpr auto operator>=(L lhs, R rhs) { return rational_compare(lhs, rhs) >= 0; }
+
+}
+
+/// @brief Evaluates a rational expression, truncating the result directly if it is not representable.
+template <typename T, typename = std::enable_if_t<detail::is_rational_operand<T>>> constexpr auto fast(T expression) {
+  return detail::evaluate<rational_mode::fast>(expression);
+}
+
+/// @brief Evaluates a rational expression, reducing the result to lowest terms before truncating it if it is not
+///        representable.
+template <typename T, typename = std::enable_if_t<detail::is_rational_operand<T>>> constexpr auto exact(T expression) {
+  return detail::evaluate<rational_mode::best>(expression);
+}
+
+
 using r16 = detail::rational<u16, u32, rational_mode::best>;
 using r32 = detail::rational<u32, u64, rational_mode::best>;
 using q16 = detail::rational<u16, u32, rational_mode::fast>;
@@ -1,68 +1,297 @@
 #include <rtl/platform.hpp>
 
-extern "C" void *memcpy(void* a, const void* b, std::size_t n)
-{
-    uint8_t* ptrA = (uint8_t*)a;
-    const uint8_t* ptrB = (const uint8_t*)b;
+// Memory and string routines for the freestanding runtime, including the memory routines of the ARM run-time ABI which
+// the compiler emits for structure copies and initialization.
+//
+// The Cortex-M0 does not support unaligned accesses, so every routine first aligns the destination a byte at a time,
+// then moves whole words (16 bytes per LDM/STM pair where possible) and finishes with the remaining bytes. Copies
+// between relatively misaligned buffers read aligned source words and merge them with shifts. The word loops are
+// RAM-resident, so they run without flash wait states.
 
-    while (n--) {
-        *(ptrA++) = *(ptrB++);
+// the loops below must not be recognized as calls to the very routines they implement
+#define no_builtin_loops __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+namespace {
+
+using rtl::u8;
+using rtl::u32;
+
+using word = u32 __attribute__((may_alias));
+
+// @brief Below this length, the alignment work costs more than it saves.
+constexpr auto word_threshold = std::size_t{8};
+
+auto word_offset(const void* pointer) {
+  return reinterpret_cast<rtl::uptr>(pointer) & 3;
+}
+
+// @brief Copies words forwards between word-aligned buffers.
+ramfunc no_builtin_loops void copy_words(word* dest, const word* src, std::size_t words) {
+  for (; words >= 4; words -= 4) {
+#if defined(__thumb__)
+    asm volatile ("ldmia %[src]!, {r3, r4, r5, r6}\n\t"
+                  "stmia %[dest]!, {r3, r4, r5, r6}"
+                  : [dest] "+l" (dest), [src] "+l" (src) : : "r3", "r4", "r5", "r6", "memory");
+#else
+    dest[0] = src[0];
+    dest[1] = src[1];
+    dest[2] = src[2];
+    dest[3] = src[3];
+    dest += 4;
+    src += 4;
+#endif
+  }
+
+  while (words--) {
+    *(dest++) = *(src++);
+  }
+}
+
+// @brief Copies words forwards to a word-aligned destination from a misaligned source.
+//
+// @remarks Only the aligned words containing source bytes are read, and each source word is read before the destination
+//          word below it is written, so this is also safe for overlapping buffers with dest < src.
+ramfunc no_builtin_loops void copy_words_shifted(word* dest, const u8* src, std::size_t words) {
+  auto offset = word_offset(src);
+  auto aligned = reinterpret_cast<const word*>(src - offset);
+  auto lo_shift = offset * 8, hi_shift = 32 - offset * 8;
+
+  auto current = *(aligned++);
+
+  while (words--) {
+    auto next = *(aligned++);
+    *(dest++) = (current >> lo_shift) | (next << hi_shift);
+    current = next;
+  }
+}
+
+// @brief Fills words with a pattern, 16 bytes per STM where possible.
+ramfunc no_builtin_loops void fill_words(word* dest, u32 pattern, std::size_t words) {
+  for (; words >= 4; words -= 4) {
+#if defined(__thumb__)
+    register u32 r3 asm("r3") = pattern;
+    register u32 r4 asm("r4") = pattern;
+    register u32 r5 asm("r5") = pattern;
+    register u32 r6 asm("r6") = pattern;
+
+    asm volatile ("stmia %[dest]!, {r3, r4, r5, r6}"
+                  : [dest] "+l" (dest) : "r" (r3), "r" (r4), "r" (r5), "r" (r6) : "memory");
+#else
+    dest[0] = pattern;
+    dest[1] = pattern;
+    dest[2] = pattern;
+    dest[3] = pattern;
+    dest += 4;
+#endif
+  }
+
+  while (words--) {
+    *(dest++) = pattern;
+  }
+}
+
+// @brief Forward copy which tolerates overlapping buffers with dest < src.
+no_builtin_loops void copy_forwards(u8* dest, const u8* src, std::size_t n) {
+  if (n >= word_threshold) {
+    while (word_offset(dest) != 0) {
+      *(dest++) = *(src++);
+      --n;
+    }
+
+    auto words = n / 4;
+
+    if (word_offset(src) == 0) {
+      copy_words(reinterpret_cast<word*>(dest), reinterpret_cast<const word*>(src), words);
+    } else {
+      copy_words_shifted(reinterpret_cast<word*>(dest), src, words);
     }
 
-    return a;
+    dest += words * 4;
+    src += words * 4;
+    n &= 3;
+  }
+
+  while (n--) {
+    *(dest++) = *(src++);
+  }
 }
 
-extern "C" void *memset(void* a, int c, std::size_t n)
-{
-    uint8_t* ptrA = (uint8_t*)a;
+// @brief Backward copy which tolerates overlapping buffers with dest > src.
+no_builtin_loops void copy_backwards(u8* dest, const u8* src, std::size_t n) {
+  dest += n;
+  src += n;
 
-    while (n--) {
-        *(ptrA++) = static_cast<uint8_t>(c);
+  if (n >= word_threshold && word_offset(dest) == word_offset(src)) {
+    while (word_offset(dest) != 0) {
+      *(--dest) = *(--src);
+      --n;
     }
 
-    return a;
+    for (; n >= 4; n -= 4) {
+      dest -= 4;
+      src -= 4;
+      *reinterpret_cast<word*>(dest) = *reinterpret_cast<const word*>(src);
+    }
+  }
+
+  while (n--) {
+    *(--dest) = *(--src);
+  }
+}
+
+no_builtin_loops void fill(u8* dest, u8 value, std::size_t n) {
+  if (n >= word_threshold) {
+    while (word_offset(dest) != 0) {
+      *(dest++) = value;
+      --n;
+    }
+
+    fill_words(reinterpret_cast<word*>(dest), value * u32{0x01010101}, n / 4);
+    dest += n & ~std::size_t{3};
+    n &= 3;
+  }
+
+  while (n--) {
+    *(dest++) = value;
+  }
+}
+
 }
 
-extern "C" int memcmp(const void* a, const void* b, std::size_t n)
-{
-    const uint8_t* ptrA = (const uint8_t*)a;
-    const uint8_t* ptrB = (const uint8_t*)b;
+extern "C" void* memcpy(void* a, const void* b, std::size_t n) {
+  copy_forwards(static_cast<u8*>(a), static_cast<const u8*>(b), n);
+  return a;
+}
+
+extern "C" void* memmove(void* a, const void* b, std::size_t n) {
+  auto dest = static_cast<u8*>(a);
+  auto src = static_cast<const u8*>(b);
+
+  if (dest <= src || dest >= src + n) {
+    copy_forwards(dest, src, n);
+  } else {
+    copy_backwards(dest, src, n);
+  }
 
-    while (n--) {
-        char x = *(ptrA++);
-        char y = *(ptrB++);
+  return a;
+}
 
-        if (x < y) {
-            return -1;
-        } else if (x > y) {
-            return 1;
-        }
+extern "C" void* memset(void* a, int c, std::size_t n) {
+  fill(static_cast<u8*>(a), static_cast<u8>(c), n);
+  return a;
+}
+
+extern "C" no_builtin_loops int memcmp(const void* a, const void* b, std::size_t n) {
+  auto lhs = static_cast<const u8*>(a);
+  auto rhs = static_cast<const u8*>(b);
+
+  if (n >= word_threshold && word_offset(lhs) == word_offset(rhs)) {
+    while (word_offset(lhs) != 0 && *lhs == *rhs) {
+      ++lhs;
+      ++rhs;
+      --n;
     }
 
-    return 0;
+    // skip over equal words, leaving the first differing word (if any) to the byte loop
+    if (word_offset(lhs) == 0) {
+      while (n >= 4 && *reinterpret_cast<const word*>(lhs) == *reinterpret_cast<const word*>(rhs)) {
+        lhs += 4;
+        rhs += 4;
+        n -= 4;
+      }
+    }
+  }
+
+  while (n--) {
+    auto x = *(lhs++);
+    auto y = *(rhs++);
+
+    if (x < y) {
+      return -1;
+    } else if (x > y) {
+      return 1;
+    }
+  }
+
+  return 0;
 }
 
-extern "C" size_t strlen(const char* str) {
-  std::size_t size = 0;
+extern "C" no_builtin_loops size_t strlen(const char* str) {
+  auto end = str;
+
+  while (word_offset(end) != 0) {
+    if (*end == '\0') {
+      return static_cast<std::size_t>(end - str);
+    }
+
+    ++end;
+  }
+
+  // a word contains a zero byte exactly when this has any bit set; reading the rest of the last word is harmless
+  for (auto w = *reinterpret_cast<const word*>(end); ((w - 0x01010101) & ~w & 0x80808080) == 0;) {
+    end += 4;
+    w = *reinterpret_cast<const word*>(end);
+  }
 
-  while (*str != '\0') {
-      size++;
-      str++;
+  while (*end != '\0') {
+    ++end;
   }
 
-  return size;
+  return static_cast<std::size_t>(end - str);
 }
 
-extern "C" void __aeabi_memcpy (void *dest, const void *src, size_t n)
-{
-  memcpy(dest, src, n);
+extern "C" void __aeabi_memcpy(void* dest, const void* src, size_t n) {
+  copy_forwards(static_cast<u8*>(dest), static_cast<const u8*>(src), n);
 }
 
-extern "C" void __aeabi_memset (void *dest, int c, size_t n)
-{
-  memset(dest, c, n);
+extern "C" void __aeabi_memcpy4(void* dest, const void* src, size_t n) {
+  copy_words(static_cast<word*>(dest), static_cast<const word*>(src), n / 4);
+  copy_forwards(static_cast<u8*>(dest) + (n & ~size_t{3}), static_cast<const u8*>(src) + (n & ~size_t{3}), n & 3);
+}
+
+extern "C" void __aeabi_memcpy8(void* dest, const void* src, size_t n) {
+  __aeabi_memcpy4(dest, src, n);
+}
+
+extern "C" void __aeabi_memmove(void* dest, const void* src, size_t n) {
+  memmove(dest, src, n);
+}
+
+extern "C" void __aeabi_memmove4(void* dest, const void* src, size_t n) {
+  memmove(dest, src, n);
+}
+
+extern "C" void __aeabi_memmove8(void* dest, const void* src, size_t n) {
+  memmove(dest, src, n);
+}
+
+// unlike memset, the run-time ABI passes the length before the value
+extern "C" void __aeabi_memset(void* dest, size_t n, int c) {
+  fill(static_cast<u8*>(dest), static_cast<u8>(c), n);
+}
+
+extern "C" void __aeabi_memset4(void* dest, size_t n, int c) {
+  fill(static_cast<u8*>(dest), static_cast<u8>(c), n);
+}
+
+extern "C" void __aeabi_memset8(void* dest, size_t n, int c) {
+  fill(static_cast<u8*>(dest), static_cast<u8>(c), n);
+}
+
+extern "C" void __aeabi_memclr(void* dest, size_t n) {
+  fill(static_cast<u8*>(dest), 0, n);
+}
+
+extern "C" void __aeabi_memclr4(void* dest, size_t n) {
+  fill(static_cast<u8*>(dest), 0, n);
+}
+
+extern "C" void __aeabi_memclr8(void* dest, size_t n) {
+  fill(static_cast<u8*>(dest), 0, n);
 }
 
 extern "C" int atexit(void (*)(void)) {
   return 0; // probably should implement that...
 }
+
+#undef no_builtin_loops
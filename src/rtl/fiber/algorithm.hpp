@@ -11,6 +11,9 @@
 /// These fibers are called in the context of interrupt handlers in order to perform some action. They can be waited on
 /// by the main thread, and more importantly, they can be composed together to carry out more elaborate actions.
 
+#include <rtl/base.hpp>
+#include <rtl/waitable.hpp>
+
 namespace rtl {
 
 inline constexpr auto sequence() {
@@ -39,7 +42,7 @@ template <typename G1, typename G2> constexpr auto sequence(G1 g1, G2 g2) {
           case rtl::waitable::status::failed:
             return rtl::waitable::status::failed;
           case rtl::waitable::status::complete:
-            (&storage.f1)->~decltype(g1())();
+            { using F1 = decltype(g1()); storage.f1.~F1(); }
             new (&storage.f2) decltype(g2())(g2());
             ++n;
         }
@@ -65,7 +68,7 @@ template <typename G1, typename G2, typename G3> constexpr auto sequence(G1 g1,
           case rtl::waitable::status::failed:
             return rtl::waitable::status::failed;
           case rtl::waitable::status::complete:
-            (&storage.f1)->~decltype(g1())();
+            { using F1 = decltype(g1()); storage.f1.~F1(); }
             new (&storage.f2) decltype(g2())(g2());
             ++n;
         }
@@ -76,7 +79,7 @@ template <typename G1, typename G2, typename G3> constexpr auto sequence(G1 g1,
           case rtl::waitable::status::failed:
             return rtl::waitable::status::failed;
           case rtl::waitable::status::complete:
-            (&storage.f2)->~decltype(g2())();
+            { using F2 = decltype(g2()); storage.f2.~F2(); }
             new (&storage.f3) decltype(g3())(g3());
             ++n;
         }
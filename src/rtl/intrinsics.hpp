@@ -8,6 +8,8 @@
 ///  * \c disable_interrupts
 ///  * \c enable_interrupts
 ///  * \c wait_for_interrupt
+///  * \c compiler_barrier
+///  * \c count_trailing_zeros
 
 #if defined(RTL_CORTEX_M0)
 #include <rtl/cortex-m0/intrinsics.hpp>
@@ -0,0 +1,32 @@
+#pragma once
+
+/// @file
+///
+/// @brief Lazily zeroed memory definitions.
+///
+/// Zeroing the BSS region at startup takes time proportional to its size, which delays recovery from every reset.
+/// Large buffers which are only needed once the application is running can instead be placed in the lazy BSS region,
+/// which is not touched by the runtime initialization and is zeroed by the application when it first needs it.
+
+#include <rtl/platform.hpp>
+
+/// @cond
+extern "C" rtl::u8 __LD_LAZY_BSS_OFF[];
+extern "C" rtl::u8 __LD_LAZY_BSS_END[];
+/// @endcond
+
+namespace rtl
+{
+
+/// @brief Attribute to mark memory as part of the lazy BSS section. Applications can define lazy BSS variables.
+///
+/// @warning Lazy BSS variables **cannot** be initialized, and have unspecified contents until \c clear_lazy_bss is
+///          called. Unlike NVRAM variables, their contents are not meant to be preserved across resets.
+#define lazy_bss section(".lazy_bss")
+
+/// @brief Zeroes every lazy BSS variable.
+inline auto clear_lazy_bss() {
+  memset(__LD_LAZY_BSS_OFF, 0, static_cast<std::size_t>(__LD_LAZY_BSS_END - __LD_LAZY_BSS_OFF));
+}
+
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+/// @file
+///
+/// @brief Integer division support.
+
+#if defined(RTL_CORTEX_M0)
+#include <rtl/cortex-m0/math/divide.hpp>
+#else
+#error "No platform selected for the RTL."
+#endif
@@ -0,0 +1,248 @@
+#pragma once
+
+/// @file
+///
+/// @brief Saturating fixed-point arithmetic.
+///
+/// A \c fixed<I, F> value is a signed two's complement integer with \c I integer bits and \c F fractional bits, plus a
+/// sign bit, stored in the smallest of \c i8, \c i16 or \c i32 which can hold it. Addition, subtraction, negation and
+/// multiplication saturate to the representable range instead of wrapping, and take a constant number of cycles; in
+/// particular 32-bit products are computed with \c rtl::smull rather than the generic 64-bit multiplication routine.
+
+#include <rtl/base.hpp>
+#include <rtl/math/multiply.hpp>
+
+namespace rtl {
+
+/// @brief Rounding applied when fractional bits are discarded.
+enum class fixed_rounding {
+  truncate,   ///< Round towards negative infinity, which is a plain arithmetic shift
+  nearest     ///< Round to nearest, with ties rounded towards positive infinity
+};
+
+namespace detail {
+
+template <std::size_t bits> using fixed_storage_t = std::conditional_t<bits <= 8, i8,
+                                                    std::conditional_t<bits <= 16, i16, i32>>;
+
+template <fixed_rounding rounding, std::size_t shift> constexpr auto round_shift(i64 value) {
+  if constexpr (shift == 0) {
+    return value;
+  } else if constexpr (rounding == fixed_rounding::nearest) {
+    return (value + (i64{1} << (shift - 1))) >> shift;
+  } else {
+    return value >> shift;
+  }
+}
+
+}
+
+template <std::size_t I, std::size_t F> struct fixed {
+  static_assert(I + F + 1 <= 32, "fixed-point type too wide");
+
+  using value_type = detail::fixed_storage_t<I + F + 1>;
+
+  static constexpr auto integer_bits = I;
+  static constexpr auto fractional_bits = F;
+
+  static constexpr auto min_raw = -(i64{1} << (I + F));
+  static constexpr auto max_raw = (i64{1} << (I + F)) - 1;
+
+  constexpr fixed() {}
+
+  /// @brief Converts an integer, saturating it to the representable range.
+  template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+  constexpr explicit fixed(T x) : raw(saturate(static_cast<i64>(x) * (i64{1} << F))) {
+    static_assert(sizeof(T) <= sizeof(i32), "conversion from 64-bit integers is not supported");
+  }
+
+  /// @brief Converts a floating-point value, rounding it to nearest and saturating it to the representable range.
+  ///
+  /// @remarks This is meant for constants; at runtime it would require the floating-point library.
+  constexpr explicit fixed(double x) : raw(from_double(x)) {}
+
+  /// @brief Converts from another fixed-point format, saturating it to the representable range.
+  template <fixed_rounding rounding = fixed_rounding::nearest, std::size_t I2, std::size_t F2>
+  static constexpr auto from(fixed<I2, F2> other) {
+    if constexpr (F2 >= F) {
+      return from_raw(saturate(detail::round_shift<rounding, F2 - F>(other.value())));
+    } else {
+      return from_raw(saturate(static_cast<i64>(other.value()) * (i64{1} << (F - F2))));
+    }
+  }
+
+  template <std::size_t I2, std::size_t F2> constexpr explicit fixed(fixed<I2, F2> other) : fixed(from(other)) {}
+
+  /// @brief Constructs a value from its raw two's complement representation.
+  static constexpr auto from_raw(i64 raw) {
+    auto result = fixed{};
+    result.raw = static_cast<value_type>(raw);
+    return result;
+  }
+
+  static constexpr auto min() { return from_raw(min_raw); }
+  static constexpr auto max() { return from_raw(max_raw); }
+
+  constexpr auto value() const { return raw; }
+
+  /// @brief Converts to an integer, rounding towards negative infinity.
+  template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>> constexpr explicit operator T() const {
+    return static_cast<T>(to_integer<fixed_rounding::truncate>());
+  }
+
+  constexpr explicit operator float() const {
+    return static_cast<float>(raw) / static_cast<float>(i64{1} << F);
+  }
+
+  /// @brief Converts to an integer with the given rounding.
+  template <fixed_rounding rounding> constexpr auto to_integer() const {
+    return static_cast<value_type>(detail::round_shift<rounding, F>(raw));
+  }
+
+  constexpr auto operator-() const {
+    return from_raw(saturate(-static_cast<i64>(raw)));
+  }
+
+  constexpr auto operator+(fixed rhs) const {
+    if constexpr (I + F + 1 < 32) {
+      // the sum of two values narrower than 32 bits cannot overflow an i32
+      return from_raw(saturate(static_cast<i32>(raw) + rhs.raw));
+    } else {
+      // the sum overflows exactly when both operands have the same sign and the sum has a different one
+      auto sum = static_cast<i32>(static_cast<u32>(raw) + static_cast<u32>(rhs.raw));
+      return ((raw ^ sum) & (rhs.raw ^ sum)) < 0 ? ((raw < 0) ? min() : max()) : from_raw(sum);
+    }
+  }
+
+  constexpr auto operator-(fixed rhs) const {
+    if constexpr (I + F + 1 < 32) {
+      return from_raw(saturate(static_cast<i32>(raw) - rhs.raw));
+    } else {
+      // the difference overflows exactly when the operands have different signs and the difference has the sign of rhs
+      auto difference = static_cast<i32>(static_cast<u32>(raw) - static_cast<u32>(rhs.raw));
+      return ((raw ^ rhs.raw) & (raw ^ difference)) < 0 ? ((raw < 0) ? min() : max()) : from_raw(difference);
+    }
+  }
+
+  /// @brief Multiplies two values, rounding the product to the format with the given rounding.
+  template <fixed_rounding rounding> static constexpr auto multiply(fixed lhs, fixed rhs) {
+    if constexpr (sizeof(value_type) < sizeof(i32)) {
+      return from_raw(saturate(detail::round_shift<rounding, F>(static_cast<i32>(lhs.raw) * rhs.raw)));
+    } else {
+      return from_raw(saturate(detail::round_shift<rounding, F>(smull(lhs.raw, rhs.raw))));
+    }
+  }
+
+  constexpr auto operator*(fixed rhs) const {
+    return multiply<fixed_rounding::nearest>(*this, rhs);
+  }
+
+  /// @brief Divides two values, rounding the quotient towards zero.
+  ///
+  /// @remarks Unlike the other operators this is not constant-time, as it needs a software division; dividing by zero
+  ///          saturates towards the sign of the dividend.
+  constexpr auto operator/(fixed rhs) const {
+    if (rhs.raw == 0) {
+      return (raw < 0) ? min() : (raw > 0) ? max() : fixed{};
+    }
+
+    if constexpr (sizeof(value_type) < sizeof(i32)) {
+      return from_raw(saturate((static_cast<i32>(raw) * (i32{1} << F)) / rhs.raw));
+    } else {
+      return from_raw(saturate(static_cast<i64>(raw) * (i64{1} << F) / rhs.raw));
+    }
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>> constexpr auto operator*(T rhs) const {
+    static_assert(sizeof(T) <= sizeof(i32), "scaling by 64-bit integers is not supported");
+
+    if constexpr (std::is_unsigned<T>::value && sizeof(T) == sizeof(i32)) {
+      // any nonzero value scaled by a factor beyond the range of i32 saturates
+      if (rhs > static_cast<T>(std::numeric_limits<i32>::max())) {
+        return (raw < 0) ? min() : (raw > 0) ? max() : fixed{};
+      }
+    }
+
+    if constexpr (sizeof(value_type) < sizeof(i32) && sizeof(T) < sizeof(i32)) {
+      return from_raw(saturate(static_cast<i32>(raw) * rhs));
+    } else {
+      return from_raw(saturate(smull(raw, static_cast<i32>(rhs))));
+    }
+  }
+
+  /// @brief Divides by an integer, rounding the quotient towards zero.
+  ///
+  /// @remarks The division is done in 32 bits, where every quotient but that of the most negative value by -1 fits;
+  ///          that one is the negation, which saturates.
+  template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>> constexpr auto operator/(T rhs) const {
+    static_assert(sizeof(T) <= sizeof(i32), "division by 64-bit integers is not supported");
+
+    if (rhs == 0) {
+      return (raw < 0) ? min() : (raw > 0) ? max() : fixed{};
+    }
+
+    if constexpr (std::is_unsigned<T>::value) {
+      constexpr auto magnitude_limit = u32{1} << (I + F);
+
+      // divisors beyond the magnitude of every value truncate the quotient to zero, and the only nonzero quotient by
+      // the largest magnitude is that of the most negative value; the other divisors fit an i32
+      if (static_cast<u32>(rhs) >= magnitude_limit) {
+        return (static_cast<u32>(rhs) == magnitude_limit && raw == min_raw) ? from_raw(-1) : fixed{};
+      }
+
+      return from_raw(static_cast<i32>(raw) / static_cast<i32>(rhs));
+    } else {
+      if (rhs == -1) {
+        return -*this;
+      }
+
+      return from_raw(static_cast<i32>(raw) / static_cast<i32>(rhs));
+    }
+  }
+
+  constexpr auto& operator+=(fixed rhs) { return *this = *this + rhs; }
+  constexpr auto& operator-=(fixed rhs) { return *this = *this - rhs; }
+  constexpr auto& operator*=(fixed rhs) { return *this = *this * rhs; }
+  constexpr auto& operator/=(fixed rhs) { return *this = *this / rhs; }
+
+  constexpr auto operator==(fixed rhs) const { return raw == rhs.raw; }
+  constexpr auto operator<(fixed rhs)  const { return raw < rhs.raw; }
+  constexpr auto operator!=(fixed rhs) const { return !(*this == rhs); }
+  constexpr auto operator>(fixed rhs)  const { return rhs < *this; }
+  constexpr auto operator<=(fixed rhs) const { return !(*this > rhs); }
+  constexpr auto operator>=(fixed rhs) const { return !(*this < rhs); }
+
+private:
+  static constexpr auto saturate(i64 x) -> value_type {
+    return static_cast<value_type>((x < min_raw) ? min_raw : (x > max_raw) ? max_raw : x);
+  }
+
+  static constexpr auto from_double(double x) -> value_type {
+    auto scaled = x * static_cast<double>(i64{1} << F);
+
+    if (scaled <= static_cast<double>(min_raw)) {
+      return static_cast<value_type>(min_raw);
+    } else if (scaled >= static_cast<double>(max_raw)) {
+      return static_cast<value_type>(max_raw);
+    }
+
+    auto truncated = static_cast<i64>(scaled);
+    auto fraction = scaled - static_cast<double>(truncated);
+
+    if (fraction >= 0.5) {
+      ++truncated;
+    } else if (fraction < -0.5) {
+      --truncated;
+    }
+
+    return saturate(truncated);
+  }
+
+  value_type raw{0};
+};
+
+using q7 = fixed<0, 7>;
+using q15 = fixed<0, 15>;
+using q31 = fixed<0, 31>;
+
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+/// @file
+///
+/// @brief Widening multiplication support.
+
+#if defined(RTL_CORTEX_M0)
+#include <rtl/cortex-m0/math/multiply.hpp>
+#else
+#error "No platform selected for the RTL."
+#endif
@@ -0,0 +1,129 @@
+#pragma once
+
+/// @file
+///
+/// @brief Integer powers and roots.
+///
+/// None of these kernels divide at runtime: powers use binary exponentiation and roots are computed one result bit at
+/// a time, so they remain cheap on processors without a hardware divider and never need a floating-point library.
+
+#include <rtl/base.hpp>
+#include <rtl/math/multiply.hpp>
+
+namespace rtl {
+
+namespace detail {
+
+// @brief Binary exponentiation in \c T, which must not overflow unless it is unsigned.
+template <typename T> constexpr T binary_power(T base, unsigned exponent) {
+  auto result = T{1};
+
+  while (exponent != 0) {
+    if (exponent & 1) {
+      result = static_cast<T>(result * base);
+    }
+
+    exponent >>= 1;
+
+    if (exponent != 0) {
+      base = static_cast<T>(base * base);
+    }
+  }
+
+  return result;
+}
+
+// @brief Returns whether base^exponent is less than or equal to limit, without overflowing.
+constexpr bool ipow_at_most(u32 base, unsigned exponent, u32 limit) {
+  auto result = u32{1};
+
+  for (auto i = 0u; i < exponent; ++i) {
+    auto product = umull_parts(result, base);
+
+    if (product.hi != 0 || product.lo > limit) {
+      return false;
+    }
+
+    result = product.lo;
+  }
+
+  return true;
+}
+
+}
+
+/// @brief Raises \c base to the power \c exponent by binary exponentiation.
+///
+/// @remarks Integral powers are computed in an unsigned type at least as wide as \c unsigned, whose overflow is well
+///          defined, and wrap around to \c T: the result is the exact power modulo 2^N for an N-bit \c T.
+template <typename T> constexpr T ipow(T base, unsigned exponent) {
+  if constexpr (std::is_integral<T>::value) {
+    using U = std::common_type_t<std::make_unsigned_t<T>, unsigned>;
+    return static_cast<T>(detail::binary_power(static_cast<U>(base), exponent));
+  } else {
+    return detail::binary_power(base, exponent);
+  }
+}
+
+/// @brief Computes the integer square root of \c x, rounded down.
+constexpr u32 isqrt(u32 x) {
+  auto result = u32{0};
+  auto bit = u32{1} << 30;
+
+  while (bit > x) {
+    bit >>= 2;
+  }
+
+  while (bit != 0) {
+    if (x >= result + bit) {
+      x -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+
+    bit >>= 2;
+  }
+
+  return result;
+}
+
+/// @brief Computes the integer \c n-th root of \c x, rounded down.
+template <unsigned n> constexpr u32 iroot(u32 x) {
+  static_assert(n != 0, "zeroth root is undefined");
+
+  if constexpr (n == 1) {
+    return x;
+  } else if constexpr (n == 2) {
+    return isqrt(x);
+  } else {
+    auto result = u32{0};
+
+    for (auto bit = u32{1} << ((31 + n) / n - 1); bit != 0; bit >>= 1) {
+      if (detail::ipow_at_most(result | bit, n, x)) {
+        result |= bit;
+      }
+    }
+
+    return result;
+  }
+}
+
+/// @brief Computes base^exponent, returning false if the result does not fit in 32 bits.
+constexpr bool checked_ipow(u32 base, unsigned exponent, u32& result) {
+  result = 1;
+
+  for (auto i = 0u; i < exponent; ++i) {
+    auto product = detail::umull_parts(result, base);
+
+    if (product.hi != 0) {
+      return false;
+    }
+
+    result = product.lo;
+  }
+
+  return true;
+}
+
+}
@@ -148,4 +148,29 @@ template <rtl::uptr address, typename T> struct mmio_rw : public mmio_ro<address
 /// @brief Shortland alias of mmio_rw.
 template <rtl::uptr address, typename T> using mmio = mmio_rw<address, T>;
 
+/// @brief Block of memory-mapped IO registers of the same type, selected at runtime by their offset from its base.
+///
+/// @remarks This is meant for data-driven register programming, such as walking a table of register values; prefer
+///          \c mmio whenever the register is known at compile time.
+template <rtl::uptr base, typename T> struct mmio_block {
+public:
+  /// @brief Overwrites the entire register at the given byte offset with the specified bits.
+  static auto write(std::size_t offset, T bits) {
+    register_at(offset) = bits;
+  }
+
+  /// @brief Reads out the bits of the register at the given byte offset.
+  static auto read(std::size_t offset) -> T {
+    return register_at(offset);
+  }
+
+private:
+  static_assert(std::is_unsigned<T>::value && std::is_integral<T>::value,
+                "MMIO register type must be an unsigned integral type");
+
+  static auto& register_at(std::size_t offset) {
+    return *reinterpret_cast<volatile T*>(base + offset);
+  }
+};
+
 }
@@ -8,6 +8,14 @@
 
 #define section(x) __attribute__((section(x)))
 
+// Places a function in the .ramtext section, which the runtime initialization copies to RAM along with the data
+// segment, so that it executes without flash wait states. Calls to it are long calls, as RAM is out of branch range.
+#if defined(__arm__)
+#define ramfunc __attribute__((__section__(".ramtext"), __long_call__, __noinline__))
+#else
+#define ramfunc __attribute__((__section__(".ramtext"), __noinline__))
+#endif
+
 #define STRINGIZE_HELPER(x) #x
 #define STRINGIZE(x) STRINGIZE_HELPER(x)
 
@@ -4,23 +4,40 @@
 ///
 /// @brief Reference counting utilities.
 
+#include <rtl/base.hpp>
+#include <rtl/intrinsics.hpp>
+
 namespace rtl {
 
+/// @brief Shared resource which is acquired by its first user and released by its last one.
+///
+/// @tparam Acquire Function object type called when the first user acquires the resource.
+/// @tparam Release Function object type called when the last user releases the resource.
+///
+/// @remarks The reference count is updated with interrupts disabled, so users may come and go from interrupt handlers.
 template <typename Acquire, typename Release> struct resource {
   void acquire() {
-    if (refcount++ == 0) {
-      Acquire();
-    }
+    rtl::intrinsics::non_preemptible([this]() {
+      if (refcount++ == 0) {
+        Acquire{}();
+      }
+    });
   }
 
   void release() {
-    if (--refcount == 0) {
-      Release();
-    }
+    rtl::intrinsics::non_preemptible([this]() {
+      if (--refcount == 0) {
+        Release{}();
+      }
+    });
+  }
+
+  auto users() const {
+    return refcount;
   }
 
 private:
-  int refcount;
+  rtl::u32 refcount{0};
 };
 
 }
@@ -0,0 +1,85 @@
+#pragma once
+
+/// @file
+///
+/// @brief Lock-free single-producer single-consumer ring buffer.
+///
+/// The ring passes items from one execution context to another without disabling interrupts, typically from an
+/// interrupt handler which pushes them to the application which drains them in bulk:
+///
+/// \code
+/// rtl::ring<sample, 64> samples;
+///
+/// samples.push(sample{...});                      // in the handler
+/// auto count = samples.pop(buffer, 16);           // in the application
+/// \endcode
+///
+/// Each index is only ever written by one side, and the items are written before the index which publishes them, so
+/// neither side can observe a partially written item.
+///
+/// @remarks Pushing to a full ring fails rather than overwriting the oldest items, which the consumer may be reading.
+
+#include <rtl/base.hpp>
+#include <rtl/intrinsics.hpp>
+
+namespace rtl
+{
+
+template <typename T, std::size_t capacity> class ring : private rtl::noncopyable {
+  static_assert(capacity != 0 && (capacity & (capacity - 1)) == 0, "ring capacity must be a power of two");
+  static_assert(capacity <= (std::size_t{1} << 31), "ring capacity too large for its indices");
+
+public:
+  constexpr ring() {}
+
+  /// @brief Appends an item, returning whether there was room for it. Only called by the producer.
+  auto push(const T& item) {
+    auto position = head;
+
+    if (position - tail == capacity) {
+      return false;
+    }
+
+    items[position % capacity] = item;
+    rtl::intrinsics::compiler_barrier();
+    head = position + 1;
+
+    return true;
+  }
+
+  /// @brief Removes up to \p count of the oldest items into \p out, returning how many. Only called by the consumer.
+  auto pop(T* out, std::size_t count) {
+    auto position = tail;
+    auto available = static_cast<std::size_t>(head - position);
+    rtl::intrinsics::compiler_barrier();
+
+    if (count > available) {
+      count = available;
+    }
+
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      out[i] = items[(position + i) % capacity];
+    }
+
+    rtl::intrinsics::compiler_barrier();
+    tail = position + static_cast<rtl::u32>(count);
+
+    return count;
+  }
+
+  /// @brief Returns the number of items in the ring, which may be stale by the time it is used.
+  auto size() const {
+    return static_cast<std::size_t>(head - tail);
+  }
+
+  auto empty() const {
+    return size() == 0;
+  }
+
+private:
+  T items[capacity]{};
+  volatile rtl::u32 head{0};
+  volatile rtl::u32 tail{0};
+};
+
+}
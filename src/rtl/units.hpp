@@ -5,10 +5,66 @@
 /// @brief Mathematical unit types.
 
 #include <rtl/base.hpp>
+#include <rtl/assert.hpp>
 #include <rtl/math/rational.hpp>
+#include <rtl/math/multiply.hpp>
+#include <rtl/math/divide.hpp>
+#include <rtl/math/power.hpp>
 
 namespace rtl {
 
+namespace detail {
+
+// @brief Computes the exact n-th root of a positive compile-time integer, or zero if it is not a perfect power.
+constexpr std::intmax_t exact_root(std::intmax_t x, std::intmax_t n) {
+  auto lo = std::intmax_t{1}, hi = x;
+
+  while (lo <= hi) {
+    auto candidate = lo + (hi - lo) / 2;
+    auto power = std::intmax_t{1};
+    auto overflow = false;
+
+    for (auto i = 0; i < n && !overflow; ++i) {
+      overflow = power > x / candidate;
+      power *= overflow ? 1 : candidate;
+    }
+
+    if (!overflow && power == x) {
+      return candidate;
+    } else if (overflow || power > x) {
+      hi = candidate - 1;
+    } else {
+      lo = candidate + 1;
+    }
+  }
+
+  return 0;
+}
+
+constexpr std::intmax_t exact_power(std::intmax_t x, std::intmax_t n) {
+  auto power = std::intmax_t{1};
+
+  for (auto i = 0; i < n; ++i) {
+    power *= x;
+  }
+
+  return power;
+}
+
+// @brief Raises a scale factor to a positive rational power, which must yield a rational scale factor.
+template <typename Scale, typename Exponent> struct scale_power {
+  static_assert(Exponent::num > 0, "only positive powers are supported");
+
+  static constexpr auto num = exact_root(exact_power(Scale::num, Exponent::num), Exponent::den);
+  static constexpr auto den = exact_root(exact_power(Scale::den, Exponent::num), Exponent::den);
+
+  static_assert(num != 0 && den != 0, "unit scale is not a perfect power, convert to another unit first");
+
+  using value = std::ratio<num, den>;
+};
+
+}
+
 template <typename _Scale,
           typename L_ = std::ratio<0>, typename M_ = std::ratio<0>, typename T_ = std::ratio<0>,
           typename I_ = std::ratio<0>, typename O_ = std::ratio<0>, typename N_ = std::ratio<0>,
@@ -74,10 +130,116 @@ struct dimension {
     using value = std::ratio_divide<Scale, typename other::Scale>;
   };
 
+  template <typename exponent> struct power {
+    using value = dimension<typename detail::scale_power<Scale, exponent>::value,
+                            std::ratio_multiply<L, exponent>,
+                            std::ratio_multiply<M, exponent>,
+                            std::ratio_multiply<T, exponent>,
+                            std::ratio_multiply<I, exponent>,
+                            std::ratio_multiply<O, exponent>,
+                            std::ratio_multiply<N, exponent>,
+                            std::ratio_multiply<J, exponent>,
+                            std::ratio_multiply<B, exponent>>;
+  };
+
+  template <typename factor> using scaled = dimension<std::ratio_multiply<Scale, factor>, L, M, T, I, O, N, J, B>;
+
   template <typename other> using times = typename product<other>::value;
   template <typename other> using per = typename quotient<other>::value;
 };
 
+/// @brief Policy selecting how a quantity is converted between commensurate units.
+///
+/// @remarks The Cortex-M0 has no divide instruction, so every runtime division is a call into the runtime library. An
+///          exact conversion by a scale which is neither integral nor the inverse of one, say 3/7, multiplies and
+///          divides in 64 bits, which costs a 64-bit division call on every conversion. Conversions on hot paths should
+///          use the \c folded policy wherever its error, given by \c rtl::conversion_error, is acceptable.
+enum class conversion {
+  automatic,  ///< Folded whenever that gives the same result as the exact conversion, exact otherwise
+  folded,     ///< Shifts and reciprocal multiplications computed at compile time, never dividing at runtime
+  exact       ///< Runtime multiplication or division by the scale factor, calling the runtime library to divide
+};
+
+namespace detail {
+
+template <u64 num, u64 den> constexpr auto folded_fraction(u32 x) {
+  static_assert(num < den, "fraction must be less than one");
+
+  if constexpr (num == 1 && (den & (den - 1)) == 0) {
+    auto shift = std::size_t{0};
+
+    while ((u64{1} << shift) != den) {
+      ++shift;
+    }
+
+    return (shift >= 32) ? u32{0} : (x >> shift);
+  } else {
+    constexpr auto reciprocal = reciprocal_of(num, den);
+    static_assert(reciprocal.multiplier != 0, "unsupported scale");
+
+    return (reciprocal.shift >= 32) ? u32{0} : (umulh(x, reciprocal.multiplier) >> reciprocal.shift);
+  }
+}
+
+// @brief Scales a 32-bit magnitude by the compile-time ratio num / den, truncating.
+template <u64 num, u64 den> constexpr auto folded_scale(u32 x) {
+  constexpr auto whole = num / den;
+  constexpr auto part = num % den;
+
+  static_assert(whole <= std::numeric_limits<u32>::max(), "scale factor too large");
+
+  auto result = static_cast<u32>(whole) * x;
+
+  if constexpr (part != 0) {
+    result += folded_fraction<part, den>(x);
+  }
+
+  return result;
+}
+
+template <typename Scale, typename T> constexpr auto folded_convert(T x) {
+  static_assert(Scale::num > 0 && Scale::den > 0, "invalid scale");
+
+  constexpr auto num = static_cast<u64>(Scale::num);
+  constexpr auto den = static_cast<u64>(Scale::den);
+
+  if constexpr (std::is_signed<T>::value) {
+    auto magnitude = (x < 0) ? u32{0} - static_cast<u32>(x) : static_cast<u32>(x);
+    auto result = folded_scale<num, den>(magnitude);
+    return static_cast<T>((x < 0) ? u32{0} - result : result);
+  } else {
+    return static_cast<T>(folded_scale<num, den>(static_cast<u32>(x)));
+  }
+}
+
+template <typename T> constexpr auto is_foldable = std::is_integral<T>::value && !std::is_same<T, bool>::value
+                                                 && sizeof(T) <= sizeof(u32);
+
+// @brief Worst-case error of a folded conversion by the given scale, in units of the last place.
+template <typename Scale> constexpr std::size_t folded_error() {
+  static_assert(Scale::num / Scale::den <= std::numeric_limits<u32>::max(), "scale factor too large");
+
+  constexpr auto num = static_cast<u64>(Scale::num) % static_cast<u64>(Scale::den);
+  constexpr auto den = static_cast<u64>(Scale::den);
+
+  if constexpr (num == 0 || (num == 1 && (den & (den - 1)) == 0)) {
+    return 0;
+  } else {
+    return reciprocal_of(num, den).exact ? 0 : 1;
+  }
+}
+
+// @brief Whether folding a conversion by the given scale gives the exact result for every 32-bit magnitude.
+template <typename Scale> constexpr bool folds_exactly() {
+  if constexpr (Scale::num / Scale::den > std::numeric_limits<u32>::max()) {
+    return false;
+  } else {
+    return folded_error<Scale>() == 0;
+  }
+}
+
+}
+
 template <typename T, typename Dimension> struct quantity {
 private:
   template <typename T2, typename OtherDimension> friend struct quantity;
@@ -91,57 +253,88 @@ public:
   constexpr explicit quantity(block_if_t<Dimension::is_dimensionless(), T> value) : value(value) {}
   constexpr quantity(block_unless_t<Dimension::is_dimensionless(), T> value) : value(value) {}
 
-  template <typename OtherDimension> constexpr auto in() const {
-    return quantity<T, OtherDimension>{*this};
+  /// @brief Converts the quantity to another unit.
+  ///
+  /// @remarks For integral types up to 32 bits wide, the \c folded policy lowers the scale factor to shifts and
+  ///          reciprocal multiplications and never divides at runtime; its worst-case deviation from the truncated
+  ///          exact result is given by \c rtl::conversion_error. The default \c automatic policy only folds scale
+  ///          factors whose error is zero, which is most of them, and otherwise behaves like the \c exact policy,
+  ///          which multiplies or divides by the scale factor at runtime (in 64 bits when neither the scale factor nor
+  ///          its inverse is integral, at the cost of a 64-bit division call). Hot paths whose scale does not fold
+  ///          exactly should therefore ask for the \c folded policy explicitly.
+  template <typename OtherDimension, conversion policy = conversion::automatic> constexpr auto in() const {
+    return convert<T, OtherDimension, policy>();
   }
 
-  template <typename OtherDimension> constexpr auto as() const {
-    return quantity<T, OtherDimension>{*this}.value;
+  template <typename OtherDimension, conversion policy = conversion::automatic> constexpr auto as() const {
+    return convert<T, OtherDimension, policy>().value;
   }
 
   template <typename T2, typename OtherDimension>
   constexpr operator quantity<T2, OtherDimension>() const {
+    return convert<T2, OtherDimension, conversion::automatic>();
+  }
+
+private:
+  template <typename T2, typename OtherDimension, conversion policy> constexpr auto convert() const
+    -> quantity<T2, OtherDimension> {
     static_assert(Dimension::template commensurate<OtherDimension>(), "incommensurate dimensions");
 
     using scale = typename Dimension::template conversion_factor<OtherDimension>::value;
 
     if constexpr (std::ratio_equal<scale, std::ratio<1>>::value) {
       return quantity<T2, OtherDimension>{static_cast<T2>(value)};
+    } else if constexpr (detail::is_foldable<T2> && (policy == conversion::folded
+                                                     || (policy == conversion::automatic
+                                                         && detail::folds_exactly<scale>()))) {
+      return quantity<T2, OtherDimension>{detail::folded_convert<scale>(static_cast<T2>(value))};
+    } else if constexpr (detail::is_foldable<T2> && scale::num != 1 && scale::den != 1
+                         && scale::num < (std::intmax_t{1} << 31)) {
+      // neither the scale nor its inverse is integral - scale in 64 bits, which cannot overflow
+      return quantity<T2, OtherDimension>{static_cast<T2>(static_cast<i64>(static_cast<T2>(value)) * scale::num
+                                                          / scale::den)};
     } else if constexpr (std::ratio_less<scale, std::ratio<1>>::value) {
       // scale is less than 1 - consider dividing by the inverse
       if constexpr (std::numeric_limits<i8>::min() <= scale::den / scale::num &&
                     std::numeric_limits<i8>::max() >= scale::den / scale::num) {
-        return quantity<T2, OtherDimension>{static_cast<T2>(value) / static_cast<i8>(scale::den / scale::num)};
+        return quantity<T2, OtherDimension>{
+          static_cast<T2>(static_cast<T2>(value) / static_cast<i8>(scale::den / scale::num))};
       } else if constexpr (std::numeric_limits<i16>::min() <= scale::den / scale::num &&
                            std::numeric_limits<i16>::max() >= scale::den / scale::num) {
-        return quantity<T2, OtherDimension>{static_cast<T2>(value) / static_cast<i16>(scale::den / scale::num)};
+        return quantity<T2, OtherDimension>{
+          static_cast<T2>(static_cast<T2>(value) / static_cast<i16>(scale::den / scale::num))};
       } else if constexpr (std::numeric_limits<i32>::min() <= scale::den / scale::num &&
                            std::numeric_limits<i32>::max() >= scale::den / scale::num) {
-        return quantity<T2, OtherDimension>{static_cast<T2>(value) / static_cast<i32>(scale::den / scale::num)};
+        return quantity<T2, OtherDimension>{
+          static_cast<T2>(static_cast<T2>(value) / static_cast<i32>(scale::den / scale::num))};
       } else if constexpr (std::numeric_limits<i64>::min() <= scale::den / scale::num &&
                            std::numeric_limits<i64>::max() >= scale::den / scale::num) {
-        return quantity<T2, OtherDimension>{static_cast<T2>(value) / static_cast<i64>(scale::den / scale::num)};
+        return quantity<T2, OtherDimension>{
+          static_cast<T2>(static_cast<T2>(value) / static_cast<i64>(scale::den / scale::num))};
       }
     } else {
       // scale is greater than 1 - just multiply by the scale
       if constexpr (std::numeric_limits<i8>::min() <= scale::num / scale::den &&
                     std::numeric_limits<i8>::max() >= scale::num / scale::den) {
-        return quantity<T2, OtherDimension>{static_cast<T2>(value) * static_cast<i8>(scale::num / scale::den)};
+        return quantity<T2, OtherDimension>{
+          static_cast<T2>(static_cast<T2>(value) * static_cast<i8>(scale::num / scale::den))};
       } else if constexpr (std::numeric_limits<i16>::min() <= scale::num / scale::den &&
                            std::numeric_limits<i16>::max() >= scale::num / scale::den) {
-        return quantity<T2, OtherDimension>{static_cast<T2>(value) * static_cast<i16>(scale::num / scale::den)};
+        return quantity<T2, OtherDimension>{
+          static_cast<T2>(static_cast<T2>(value) * static_cast<i16>(scale::num / scale::den))};
       } else if constexpr (std::numeric_limits<i32>::min() <= scale::num / scale::den &&
                            std::numeric_limits<i32>::max() >= scale::num / scale::den) {
-        return quantity<T2, OtherDimension>{static_cast<T2>(value) * static_cast<i32>(scale::num / scale::den)};
+        return quantity<T2, OtherDimension>{
+          static_cast<T2>(static_cast<T2>(value) * static_cast<i32>(scale::num / scale::den))};
       } else if constexpr (std::numeric_limits<i64>::min() <= scale::num / scale::den &&
                            std::numeric_limits<i64>::max() >= scale::num / scale::den) {
-        return quantity<T2, OtherDimension>{static_cast<T2>(value) * static_cast<i64>(scale::num / scale::den)};
+        return quantity<T2, OtherDimension>{
+          static_cast<T2>(static_cast<T2>(value) * static_cast<i64>(scale::num / scale::den))};
       }
     }
   }
 
-  // TODO: need pow function
-
+public:
   constexpr auto operator-() const {
     return quantity<T, Dimension>{-value};
   }
@@ -173,22 +366,81 @@ private:
   T value;
 };
 
-template <typename T, typename Dimension, typename T2>
+namespace detail {
+
+template <typename T> constexpr auto is_quantity = false;
+template <typename T, typename Dimension> constexpr auto is_quantity<quantity<T, Dimension>> = true;
+
+}
+
+/// @brief Worst-case error of a folded conversion between two units, in units of the last place.
+template <typename Dimension, typename OtherDimension> constexpr auto conversion_error
+  = detail::folded_error<typename Dimension::template conversion_factor<OtherDimension>::value>();
+
+/// @brief Raises a quantity to a positive rational power.
+///
+/// @remarks Integral powers of any arithmetic type are computed by \c ipow and wrap around to the quantity's type on
+///          overflow. Fractional powers require an integral type of at most 32 bits and are computed as the
+///          rounded-down root of the integral power, which must not overflow 32 bits; even roots of negative values and
+///          overflowing powers trip an assert. The scale of the unit must itself be a perfect power.
+template <typename Exponent, typename T, typename Dimension> constexpr auto pow(quantity<T, Dimension> q) {
+  using exponent = typename Exponent::type;
+  using result = quantity<T, typename Dimension::template power<exponent>::value>;
+
+  auto value = q.template as<Dimension>();
+
+  if constexpr (exponent::den == 1) {
+    return result{ipow(value, static_cast<unsigned>(exponent::num))};
+  } else {
+    static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(u32),
+                  "fractional powers require an integral quantity of at most 32 bits");
+
+    auto negative = std::is_signed<T>::value && value < T{0};
+    auto magnitude = negative ? u32{0} - static_cast<u32>(value) : static_cast<u32>(value);
+
+    if (negative && exponent::den % 2 == 0) {
+      rtl::assert(false, TRACE("even root of a negative quantity"));
+    }
+
+    auto power = u32{0};
+
+    if (!checked_ipow(magnitude, static_cast<unsigned>(exponent::num), power)) {
+      rtl::assert(false, TRACE("power overflows 32 bits"));
+    }
+
+    auto root = iroot<static_cast<unsigned>(exponent::den)>(power);
+    auto odd = exponent::num % 2 == 1;
+
+    return result{static_cast<T>((negative && odd) ? u32{0} - root : root)};
+  }
+}
+
+/// @brief Raises a quantity to a positive integral power.
+template <std::intmax_t N, typename T, typename Dimension> constexpr auto pow(quantity<T, Dimension> q) {
+  return pow<std::ratio<N>>(q);
+}
+
+/// @brief Computes the square root of a quantity, rounded down.
+template <typename T, typename Dimension> constexpr auto sqrt(quantity<T, Dimension> q) {
+  return pow<std::ratio<1, 2>>(q);
+}
+
+template <typename T, typename Dimension, typename T2, typename = std::enable_if_t<!detail::is_quantity<T2>>>
 constexpr auto operator*(quantity<T, Dimension> lhs, T2 rhs) {
   return lhs * quantity<T, dimension<std::ratio<1>>>{static_cast<T>(rhs)};
 }
 
-template <typename T, typename Dimension, typename T2>
+template <typename T, typename Dimension, typename T2, typename = std::enable_if_t<!detail::is_quantity<T2>>>
 constexpr auto operator*(T2 lhs, quantity<T, Dimension> rhs) {
   return rhs * quantity<T, dimension<std::ratio<1>>>{static_cast<T>(lhs)};
 }
 
-template <typename T, typename Dimension, typename T2>
+template <typename T, typename Dimension, typename T2, typename = std::enable_if_t<!detail::is_quantity<T2>>>
 constexpr auto operator/(quantity<T, Dimension> lhs, T2 rhs) {
   return lhs / quantity<T, dimension<std::ratio<1>>>{static_cast<T>(rhs)};
 }
 
-template <typename T, typename Dimension, typename T2>
+template <typename T, typename Dimension, typename T2, typename = std::enable_if_t<!detail::is_quantity<T2>>>
 constexpr auto operator/(T2 lhs, quantity<T, Dimension> rhs) {
   return rhs / quantity<T, dimension<std::ratio<1>>>{static_cast<T>(lhs)};
 }
@@ -210,9 +462,9 @@ namespace rtl {
 #define MOLE                      EXPAND( 0,  0,  0,  0,  0, +1,  0,  0)
 #define CANDELA                   EXPAND( 0,  0,  0,  0,  0,  0, +1,  0)
 #define INFORMATION               EXPAND( 0,  0,  0,  0,  0,  0,  0, +1)
-#define VELOCITY                  EXPAND(+1, -1,  0,  0,  0,  0,  0,  0)
-#define ACCELERATION              EXPAND(+1, -2,  0,  0,  0,  0,  0,  0)
-#define FREQUENCY                 EXPAND( 0, -1,  0,  0,  0,  0,  0,  0)
+#define VELOCITY                  EXPAND(+1,  0, -1,  0,  0,  0,  0,  0)
+#define ACCELERATION              EXPAND(+1,  0, -2,  0,  0,  0,  0,  0)
+#define FREQUENCY                 EXPAND( 0,  0, -1,  0,  0,  0,  0,  0)
 
 using dimensionless = dimension<std::ratio<1>, DIMENSIONLESS>;
 using meter         = dimension<std::ratio<1>, LENGTH>;
@@ -251,6 +503,9 @@ using day           = dimension<std::ratio<3600 * 24>, TIME>;
 #undef MOLE
 #undef CANDELA
 #undef INFORMATION
+#undef VELOCITY
+#undef ACCELERATION
+#undef FREQUENCY
 
 }
 
@@ -265,6 +520,7 @@ using day           = dimension<std::ratio<3600 * 24>, TIME>;
 DEFINE_ABBREV(m, meter)
 DEFINE_ABBREV(km, kilometer)
 DEFINE_ABBREV(g, gram)
+DEFINE_ABBREV(us, microsecond)
 DEFINE_ABBREV(ms, millisecond)
 DEFINE_ABBREV(s, second)
 DEFINE_ABBREV(Hz, hertz)
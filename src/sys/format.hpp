@@ -22,33 +22,53 @@ inline auto format_str(const char* buf) {
   };
 }
 
+// @brief Formats a signed integer.
+//
+// @remarks The digits are carried by the fiber itself, so any number of integer fibers may be live at once.
 inline auto format_int(rtl::i64 n) {
-  static char buffer[32] = {};
-  std::size_t pos = 31;
+  char digits[20] = {};
+  auto count = std::size_t{0};
 
-  auto negative = (n < 0);
-  if (negative) {
-    n = -n;
-  }
+  auto magnitude = (n < 0) ? rtl::u64{0} - static_cast<rtl::u64>(n) : static_cast<rtl::u64>(n);
 
-  buffer[pos--] = '\0';
+  do {
+    digits[count++] = static_cast<char>('0' + (magnitude % 10));
+    magnitude /= 10;
+  } while (magnitude != 0);
 
-  if (n == 0) {
-    buffer[pos--] = '0';
-  } else while (n != 0) {
-    buffer[pos--] = '0' + (n % 10);
-    n /= 10;
+  if (n < 0) {
+    digits[count++] = '-';
   }
 
-  if (negative) {
-    buffer[pos--] = '-';
-  }
+  return [digits, count](rtl::u8& data) mutable {
+    if (count == 0) {
+      return rtl::waitable::status::complete;
+    }
 
-  return format_str(buffer + pos + 1);
+    data = digits[--count];
+    return rtl::waitable::status::pending;
+  };
 }
 
 }
 
+/// @brief Maximum number of characters a formatter can emit for a value of type \c T.
+///
+/// @remarks Types without a bounded width, such as strings, report \c bounded as false.
+template <typename T, typename = void> struct format_width {
+  static constexpr auto bounded = false;
+  static constexpr auto value = std::size_t{0};
+};
+
+template <typename T> struct format_width<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+  static constexpr auto bounded = true;
+  static constexpr auto value = std::size_t{std::numeric_limits<T>::digits10 + 1 + std::is_signed<T>::value};
+};
+
+/// @brief Maximum number of characters formatting values of types \c T... can emit, or zero if unbounded.
+template <typename... T> constexpr auto max_format_length = (format_width<T>::bounded && ...)
+                                                          ? (format_width<T>::value + ... + 0) : 0;
+
 /// @brief Base definition for a formatter.
 ///
 /// @remarks Additional specializations over the \c T type with custom format strings can be introduced.
@@ -85,6 +105,11 @@ template <typename T> auto formatter_generator(std::pair<const char*, T> fragmen
   return [fragment{std::move(fragment)}]() { return formatter(fragment); };
 }
 
+template <typename T> struct is_fragment : std::false_type {};
+template <typename T> struct is_fragment<std::pair<const char*, T>> : std::true_type {};
+
+template <typename... Args> constexpr auto all_fragments = (is_fragment<typename std::decay<Args>::type>::value && ...);
+
 }
 
 /// @brief Formatting function.
@@ -92,4 +117,55 @@ template <typename... Args> auto format(Args&&... args) {
   return rtl::sequence(detail::formatter_generator(std::forward<Args>(args))...);
 }
 
+/// @brief Result of formatting into a buffer.
+struct format_result {
+  std::size_t length; ///< Length of the complete output, excluding the null terminator
+  bool truncated;     ///< Whether the output had to be truncated to fit the buffer
+};
+
+/// @brief Drains a format fiber into a buffer of \c size characters, which is always null-terminated.
+///
+/// @remarks Like \c snprintf, the returned length is that of the complete output even when it was truncated, and a
+///          null buffer of size zero can be passed to measure the output without writing it.
+template <typename T> auto write_to(char* buffer, std::size_t size, T fiber) {
+  auto length = std::size_t{0};
+  auto data = rtl::u8{};
+
+  while (fiber(data) == rtl::waitable::status::pending) {
+    if (length + 1 < size) {
+      buffer[length] = static_cast<char>(data);
+    }
+
+    ++length;
+  }
+
+  if (size != 0) {
+    buffer[(length < size) ? length : size - 1] = '\0';
+  }
+
+  return format_result{length, length >= size};
+}
+
+/// @brief Formats into a buffer of \c size characters.
+template <typename... Args> auto format_to(char* buffer, std::size_t size, Args&&... args) {
+  return write_to(buffer, size, format(std::forward<Args>(args)...));
+}
+
+/// @brief Formats into a character array.
+///
+/// @remarks If all formatted types have bounded widths, the array is checked at compile time to be large enough for
+///          any output, in which case the result can never be truncated.
+template <std::size_t N, typename... Args, typename = typename std::enable_if<detail::all_fragments<Args...>>::type>
+auto format_to(char (&buffer)[N], Args&&... args) {
+  constexpr auto max_length = max_format_length<typename std::decay<Args>::type::second_type...>;
+  static_assert(max_length == 0 || max_length < N, "buffer too small for the formatted types");
+
+  return format_to(static_cast<char*>(buffer), N, std::forward<Args>(args)...);
+}
+
+/// @brief Returns the number of characters the formatted output consists of.
+template <typename... Args> auto format_length(Args&&... args) {
+  return format_to(nullptr, 0, std::forward<Args>(args)...).length;
+}
+
 }
@@ -0,0 +1,291 @@
+#pragma once
+
+/// @file
+///
+/// @brief Data scanning utilities.
+///
+/// Scanners are the input counterpart of formatters: they are waitable fibers taking a const reference to an
+/// \c rtl::u8 which parse a field incrementally, one byte at a time, as it is received. No line buffering takes place,
+/// so a scanner completes in the interrupt handler as soon as the byte terminating its field arrives.
+///
+/// Each field is described by a fragment, a pair whose first element lists the bytes which terminate the field and
+/// whose second element describes where to store the parsed value. The terminating byte is consumed by the field.
+
+#include <rtl/base.hpp>
+#include <rtl/fiber/algorithm.hpp>
+
+namespace sys {
+
+/// @brief Hexadecimal integer field, with an optional \c 0x prefix.
+template <typename T> struct hex_field {
+  T* value;
+};
+
+/// @brief Fixed-point decimal field, stored as an integer scaled by \c 10^decimals.
+///
+/// @remarks Fractional digits beyond the requested precision are validated but truncated.
+template <std::size_t decimals, typename T> struct fixed_field {
+  T* value;
+};
+
+/// @brief Token field, copied into a null-terminated character buffer.
+struct token_field {
+  char* buffer;
+  std::size_t size;
+};
+
+template <typename T> constexpr auto hex(T* value) {
+  return hex_field<T>{value};
+}
+
+template <std::size_t decimals, typename T> constexpr auto fixed(T* value) {
+  return fixed_field<decimals, T>{value};
+}
+
+template <std::size_t N> constexpr auto token(char (&buffer)[N]) {
+  return token_field{buffer, N};
+}
+
+namespace detail {
+
+inline auto is_terminator(const char* terminators, rtl::u8 data) {
+  for (; *terminators != '\0'; ++terminators) {
+    if (static_cast<rtl::u8>(*terminators) == data) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+inline auto digit_value(rtl::u8 data) -> rtl::u8 {
+  if (data >= '0' && data <= '9') {
+    return data - '0';
+  } else if (data >= 'a' && data <= 'f') {
+    return data - 'a' + 10;
+  } else if (data >= 'A' && data <= 'F') {
+    return data - 'A' + 10;
+  } else {
+    return 0xFF;
+  }
+}
+
+// @brief Computes magnitude * base + digit, returning false on overflow.
+//
+// @remarks The overflow bounds are compile-time constants, so this never divides at runtime.
+template <typename U, unsigned base> auto accumulate(U& magnitude, rtl::u8 digit) {
+  constexpr auto limit = std::numeric_limits<U>::max() / base;
+  constexpr auto last_digit = std::numeric_limits<U>::max() % base;
+
+  if (magnitude > limit || (magnitude == limit && digit > last_digit)) {
+    return false;
+  }
+
+  magnitude = static_cast<U>(magnitude * base + digit);
+  return true;
+}
+
+// @brief Stores a parsed magnitude into its destination, returning false if it is out of range.
+template <typename T, typename U> auto store(T* value, U magnitude, bool negative) {
+  if constexpr (std::is_signed<T>::value) {
+    constexpr auto positive_limit = static_cast<U>(std::numeric_limits<T>::max());
+
+    if (magnitude > positive_limit + (negative ? 1 : 0)) {
+      return false;
+    }
+
+    *value = negative ? static_cast<T>(U{0} - magnitude) : static_cast<T>(magnitude);
+  } else {
+    if (negative && magnitude != 0) {
+      return false;
+    }
+
+    *value = static_cast<T>(magnitude);
+  }
+
+  return true;
+}
+
+template <typename T, unsigned base> auto scan_int(T* value, const char* terminators) {
+  using U = typename std::make_unsigned<T>::type;
+
+  return [value, terminators, magnitude = U{0}, digits = std::size_t{0},
+          negative = false, prefixed = false](const rtl::u8& data) mutable {
+    if (is_terminator(terminators, data)) {
+      if (digits == 0 || !store(value, magnitude, negative)) {
+        return rtl::waitable::status::failed;
+      }
+
+      return rtl::waitable::status::complete;
+    }
+
+    if (data == '-' && base == 10 && digits == 0 && !negative) {
+      negative = true;
+      return rtl::waitable::status::pending;
+    }
+
+    if ((data == 'x' || data == 'X') && base == 16 && digits == 1 && magnitude == 0 && !prefixed) {
+      prefixed = true;
+      digits = 0;
+      return rtl::waitable::status::pending;
+    }
+
+    auto digit = digit_value(data);
+
+    if (digit >= base || !accumulate<U, base>(magnitude, digit)) {
+      return rtl::waitable::status::failed;
+    }
+
+    ++digits;
+    return rtl::waitable::status::pending;
+  };
+}
+
+template <std::size_t decimals, typename T> auto scan_fixed(T* value, const char* terminators) {
+  using U = typename std::make_unsigned<T>::type;
+
+  return [value, terminators, magnitude = U{0}, digits = std::size_t{0}, fraction_digits = std::size_t{0},
+          negative = false, fraction = false](const rtl::u8& data) mutable {
+    if (is_terminator(terminators, data)) {
+      if (digits == 0) {
+        return rtl::waitable::status::failed;
+      }
+
+      for (; fraction_digits < decimals; ++fraction_digits) {
+        if (!accumulate<U, 10>(magnitude, 0)) {
+          return rtl::waitable::status::failed;
+        }
+      }
+
+      if (!store(value, magnitude, negative)) {
+        return rtl::waitable::status::failed;
+      }
+
+      return rtl::waitable::status::complete;
+    }
+
+    if (data == '-' && digits == 0 && !negative && !fraction) {
+      negative = true;
+      return rtl::waitable::status::pending;
+    }
+
+    if (data == '.' && !fraction) {
+      fraction = true;
+      return rtl::waitable::status::pending;
+    }
+
+    auto digit = digit_value(data);
+
+    if (digit >= 10) {
+      return rtl::waitable::status::failed;
+    }
+
+    ++digits;
+
+    if (fraction) {
+      if (fraction_digits == decimals) {
+        return rtl::waitable::status::pending; // truncated
+      }
+
+      ++fraction_digits;
+    }
+
+    if (!accumulate<U, 10>(magnitude, digit)) {
+      return rtl::waitable::status::failed;
+    }
+
+    return rtl::waitable::status::pending;
+  };
+}
+
+inline auto scan_token(token_field token, const char* terminators) {
+  return [token, terminators, length = std::size_t{0}](const rtl::u8& data) mutable {
+    if (is_terminator(terminators, data)) {
+      token.buffer[length] = '\0';
+      return rtl::waitable::status::complete;
+    }
+
+    if (length + 1 >= token.size) {
+      token.buffer[length] = '\0';
+      return rtl::waitable::status::failed;
+    }
+
+    token.buffer[length++] = static_cast<char>(data);
+    return rtl::waitable::status::pending;
+  };
+}
+
+}
+
+/// @brief Decimal integer scanner, accepting a leading minus sign for signed types.
+template <typename T> auto scanner(const std::pair<const char*, T*>& fragment) {
+  static_assert(std::is_integral<T>::value, "no scanner for this type");
+  return detail::scan_int<T, 10>(fragment.second, fragment.first);
+}
+
+/// @brief Hexadecimal integer scanner.
+template <typename T> auto scanner(const std::pair<const char*, hex_field<T>>& fragment) {
+  static_assert(std::is_integral<T>::value, "hexadecimal fields must be integral");
+  return detail::scan_int<T, 16>(fragment.second.value, fragment.first);
+}
+
+/// @brief Fixed-point decimal scanner.
+template <std::size_t decimals, typename T>
+auto scanner(const std::pair<const char*, fixed_field<decimals, T>>& fragment) {
+  static_assert(std::is_integral<T>::value, "fixed-point fields must be integral");
+  return detail::scan_fixed<decimals, T>(fragment.second.value, fragment.first);
+}
+
+/// @brief Token scanner.
+inline auto scanner(const std::pair<const char*, token_field>& fragment) {
+  return detail::scan_token(fragment.second, fragment.first);
+}
+
+namespace detail {
+
+template <typename T> auto scanner_generator(std::pair<const char*, T> fragment) {
+  return [fragment{std::move(fragment)}]() { return scanner(fragment); };
+}
+
+// @brief Skips the first invocation of a fiber.
+//
+// @remarks The sequence primitive invokes each fiber with the arguments its predecessor completed on, which for a
+//          scanner is the terminating byte it already consumed, so that first invocation is skipped.
+template <typename Fiber> auto skip_first(Fiber fiber) {
+  return [fiber = std::move(fiber), skip = true](const rtl::u8& data) mutable {
+    if (skip) {
+      skip = false;
+      return rtl::waitable::status::pending;
+    }
+
+    return fiber(data);
+  };
+}
+
+// @brief Generator for every field but the first.
+template <typename T> auto continuation_generator(std::pair<const char*, T> fragment) {
+  return [fragment{std::move(fragment)}]() { return skip_first(scanner(fragment)); };
+}
+
+}
+
+/// @brief Scanning function.
+///
+/// The resulting fiber parses each field in turn and completes on the byte terminating the last one, or fails on the
+/// first malformed or out-of-range field. Numeric destinations are only written once their field is complete.
+///
+/// @remarks As \c rtl::sequence composes at most three fibers, the fields beyond the second are scanned by a nested
+///          scan taking the place of the third fiber.
+template <typename First, typename... Rest> auto scan(First&& first, Rest&&... rest) {
+  return rtl::sequence(detail::scanner_generator(std::forward<First>(first)),
+                       detail::continuation_generator(std::forward<Rest>(rest))...);
+}
+
+template <typename First, typename Second, typename Third, typename Fourth, typename... Rest>
+auto scan(First&& first, Second&& second, Third&& third, Fourth&& fourth, Rest&&... rest) {
+  return rtl::sequence(detail::scanner_generator(std::forward<First>(first)),
+                       detail::continuation_generator(std::forward<Second>(second)),
+                       [third, fourth, rest...]() { return detail::skip_first(scan(third, fourth, rest...)); });
+}
+
+}